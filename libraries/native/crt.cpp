@@ -5,6 +5,8 @@
 #include <cstdint>
 #include <functional>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <setjmp.h>
 
 sysio::cdt::output_stream std_out;
@@ -12,7 +14,11 @@ sysio::cdt::output_stream std_err;
 
 extern "C" {
    int main(int, char**);
-   char* _mmap();
+   char* ___reserve(size_t size);
+   long ___commit(void* addr, size_t size);
+   int ___create_file(const char* path);
+   long ___write(int fd, const void* data, size_t size);
+   int ___close(int fd);
 
    static jmp_buf env;
    static jmp_buf test_env;
@@ -24,6 +30,7 @@ extern "C" {
    size_t ___pages;
    void ___putc(char c);
    bool ___disable_output;
+   bool ___capture_output;
    bool ___has_failed;
    bool ___earlier_unit_test_has_failed;
 
@@ -35,32 +42,123 @@ extern "C" {
       return ___pages;
    }
 
+   // the heap reserves address space up front and makes it accessible a step at a time as pages are grown
+   static constexpr size_t wasm_page_size       = 64 * 1024;
+   static constexpr size_t heap_commit_step     = 1024 * 1024;
+   static constexpr size_t default_heap_limit   = size_t(4) << 30;
+   static constexpr size_t default_heap_reserve = size_t(64) << 30;
+   static size_t heap_reserved;
+   static size_t heap_committed;
+   static size_t heap_max_bytes;
+
+   // like memory.grow, returns the previous number of pages or -1 when the memory cannot grow
    size_t _grow_memory(size_t size) {
-      if ((___heap_ptr + (size*64*1024)) > (___heap_ptr + 100*1024*1024))
-         sysio_assert(false, "__builtin_wasm_grow_memory");
-      ___heap_ptr += (size*64*1024);
-      return ++___pages;
+      const size_t pages = ___pages;
+      if (size > heap_max_bytes / wasm_page_size - pages)
+         return -1;
+      const size_t used = (pages + size) * wasm_page_size;
+      if (used > heap_committed) {
+         size_t committed = (used + heap_commit_step - 1) / heap_commit_step * heap_commit_step;
+         committed = committed < heap_reserved ? committed : heap_reserved;
+         if (___commit(___heap + heap_committed, committed - heap_committed) < 0)
+            return -1;
+         heap_committed = committed;
+      }
+      ___pages += size;
+      ___heap_ptr = ___heap + ___pages * wasm_page_size;
+      return pages;
+   }
+
+   // bytes of output waiting to be written to stdout
+   static char   output_buffer[64 * 1024];
+   static size_t output_buffered = 0;
+   static sysio::cdt::flush_policy output_flush_policy = sysio::cdt::flush_policy::line;
+
+   static void write_all(int fd, const char* data, size_t size) {
+      while (size) {
+         const long written = ___write(fd, data, size);
+         if (written <= 0)
+            return;
+         data += written;
+         size -= written;
+      }
    }
 
+   static void write_output(const char* cstr, size_t len) {
+      if (output_flush_policy == sysio::cdt::flush_policy::unbuffered) {
+         write_all(1, cstr, len);
+         return;
+      }
+      if (len > sizeof(output_buffer) - output_buffered) {
+         sysio::cdt::flush_output();
+         // too large to buffer, written as is
+         if (len > sizeof(output_buffer)) {
+            write_all(1, cstr, len);
+            return;
+         }
+      }
+      memcpy(output_buffer + output_buffered, cstr, len);
+      output_buffered += len;
+      if (output_flush_policy == sysio::cdt::flush_policy::line && memchr(cstr, '\n', len))
+         sysio::cdt::flush_output();
+   }
+
+   // output is captured for expect_print and expect_assert, and written unless it is silenced
    void _prints_l(const char* cstr, uint32_t len, uint8_t which) {
-      for (int i=0; i < len; i++) {
+      if (___capture_output) {
          if (which == sysio::cdt::output_stream_kind::std_out)
-            std_out.push(cstr[i]);
+            std_out.append(cstr, len);
          else if (which == sysio::cdt::output_stream_kind::std_err)
-            std_err.push(cstr[i]);
-         if (!___disable_output)
-            ___putc(cstr[i]);
+            std_err.append(cstr, len);
       }
+      if (!___disable_output)
+         write_output(cstr, len);
    }
 
    void _prints(const char* cstr, uint8_t which) {
-      for (int i=0; cstr[i] != '\0'; i++) {
-         if (which == sysio::cdt::output_stream_kind::std_out)
-            std_out.push(cstr[i]);
-         else if (which == sysio::cdt::output_stream_kind::std_err)
-            std_err.push(cstr[i]);
-         if (!___disable_output)
-            ___putc(cstr[i]);
+      _prints_l(cstr, strlen(cstr), which);
+   }
+
+   // called when tests are compiled with -fnative-count-blocks, once per module and then on every basic block
+   void __sanitizer_cov_trace_pc_guard_init(uint32_t* start, uint32_t* stop) {
+      sysio::native::cost_model::blocks_counted = true;
+      for (uint32_t* guard = start; guard < stop; ++guard)
+         *guard = 1;
+   }
+
+   void __sanitizer_cov_trace_pc_guard(uint32_t*) {
+      ++sysio::native::cost_model::current.basic_blocks;
+   }
+
+   // the environment follows argv
+   static const char* find_env(int argc, char** argv, const char* var) {
+      const size_t size = strlen(var);
+      for (char** env = argv + argc + 1; *env; ++env) {
+         if (strncmp(*env, var, size) == 0 && (*env)[size] == '=')
+            return *env + size + 1;
+      }
+      return nullptr;
+   }
+
+   // writes the cost report to the file named by SYSIO_NATIVE_COST_REPORT
+   static void write_cost_report(int argc, char** argv) {
+      const char* path = find_env(argc, argv, "SYSIO_NATIVE_COST_REPORT");
+      if (!path || !*path)
+         return;
+
+      const std::string report = sysio::native::cost_model::to_json();
+      const int fd = ___create_file(path);
+      bool written = fd >= 0;
+      for (size_t offset = 0; written && offset < report.size();) {
+         const long size = ___write(fd, report.data() + offset, report.size() - offset);
+         written = size > 0;
+         offset += written ? size : 0;
+      }
+      if (fd >= 0)
+         ___close(fd);
+      if (!written) {
+         ___disable_output = false;
+         _prints("error : could not write the cost report\n", sysio::cdt::output_stream_kind::std_err);
       }
    }
 
@@ -71,17 +169,63 @@ extern "C" {
       ___env_ptr = &env;
    }
 
+   // a size in bytes, optionally followed by K, M or G
+   static size_t parse_size(const char* s) {
+      char* end = nullptr;
+      const unsigned long long value = strtoull(s, &end, 10);
+      switch (*end) {
+         case 'K': case 'k': return value << 10;
+         case 'M': case 'm': return value << 20;
+         case 'G': case 'g': return value << 30;
+         default:            return value;
+      }
+   }
+
+   static bool init_heap(int argc, char** argv) {
+      heap_max_bytes = default_heap_limit;
+      if (const char* limit = find_env(argc, argv, "SYSIO_NATIVE_HEAP_LIMIT"))
+         heap_max_bytes = parse_size(limit);
+      heap_max_bytes = (heap_max_bytes + heap_commit_step - 1) / heap_commit_step * heap_commit_step;
+      if (heap_max_bytes < heap_commit_step)
+         heap_max_bytes = heap_commit_step;
+
+      // address space is cheap, so more than the limit is reserved and the limit can be raised at runtime
+      heap_reserved = heap_max_bytes > default_heap_reserve ? heap_max_bytes : default_heap_reserve;
+      ___heap = ___reserve(heap_reserved);
+      if (intptr_t(___heap) < 0 && heap_reserved > heap_max_bytes) {
+         heap_reserved = heap_max_bytes;
+         ___heap = ___reserve(heap_reserved);
+      }
+      if (intptr_t(___heap) < 0 || ___commit(___heap, heap_commit_step) < 0)
+         return false;
+      heap_committed = heap_commit_step;
+      ___pages = 1;
+      ___heap_ptr = ___heap + wasm_page_size;
+      ___heap_base_ptr = ___heap;
+      return true;
+   }
+
    int _wrap_main(int argc, char** argv) {
       using namespace sysio::native;
       int ret_val = 0;
-      ___heap = _mmap();
-      ___heap_ptr = ___heap;
-      ___heap_base_ptr = ___heap;
-      ___pages = 1;
       ___disable_output = false;
+      ___capture_output = true;
       ___has_failed = false;
       ___earlier_unit_test_has_failed = false;
 
+      if (const char* policy = find_env(argc, argv, "SYSIO_NATIVE_FLUSH")) {
+         if (strcmp(policy, "unbuffered") == 0)
+            output_flush_policy = sysio::cdt::flush_policy::unbuffered;
+         else if (strcmp(policy, "full") == 0)
+            output_flush_policy = sysio::cdt::flush_policy::full;
+      }
+
+      if (!init_heap(argc, argv)) {
+         _prints("error : could not reserve the native heap\n", sysio::cdt::output_stream_kind::none);
+         sysio::cdt::flush_output();
+         return -1;
+      }
+
       // preset the print functions
       intrinsics::set_intrinsic<intrinsics::prints_l>([](const char* cs, uint32_t l) {
             _prints_l(cs, l, sysio::cdt::output_stream_kind::std_out);
@@ -90,18 +234,24 @@ extern "C" {
             _prints(cs, sysio::cdt::output_stream_kind::std_out);
          });
       intrinsics::set_intrinsic<intrinsics::printi>([](int64_t v) {
-            printf("%lli", v);
+            char buff[32];
+            _prints_l(buff, snprintf(buff, sizeof(buff), "%lli", v), sysio::cdt::output_stream_kind::std_out);
          });
       intrinsics::set_intrinsic<intrinsics::printui>([](uint64_t v) {
-            printf("%llu", v);
+            char buff[32];
+            _prints_l(buff, snprintf(buff, sizeof(buff), "%llu", v), sysio::cdt::output_stream_kind::std_out);
          });
       intrinsics::set_intrinsic<intrinsics::printi128>([](const int128_t* v) {
             int* tmp = (int*)v;
-            printf("0x%04x%04x%04x%04x", tmp[0], tmp[1], tmp[2], tmp[3]);
+            char buff[48];
+            _prints_l(buff, snprintf(buff, sizeof(buff), "0x%04x%04x%04x%04x", tmp[0], tmp[1], tmp[2], tmp[3]),
+                      sysio::cdt::output_stream_kind::std_out);
          });
       intrinsics::set_intrinsic<intrinsics::printui128>([](const uint128_t* v) {
             int* tmp = (int*)v;
-            printf("0x%04x%04x%04x%04x", tmp[0], tmp[1], tmp[2], tmp[3]);
+            char buff[48];
+            _prints_l(buff, snprintf(buff, sizeof(buff), "0x%04x%04x%04x%04x", tmp[0], tmp[1], tmp[2], tmp[3]),
+                      sysio::cdt::output_stream_kind::std_out);
          });
       intrinsics::set_intrinsic<intrinsics::printsf>([](float v) {
             char buff[512] = {0};
@@ -115,7 +265,7 @@ extern "C" {
                buff[i] = ((int)v)+'0';
                v -= (int)v;
             }
-            prints(buff);
+            _prints(buff, sysio::cdt::output_stream_kind::std_out);
          });
       intrinsics::set_intrinsic<intrinsics::printdf>([](double v) {
             char buff[512] = {0};
@@ -129,15 +279,17 @@ extern "C" {
                buff[i] = ((int)v)+'0';
                v -= (int)v;
             }
-            prints(buff);
+            _prints(buff, sysio::cdt::output_stream_kind::std_out);
          });
       intrinsics::set_intrinsic<intrinsics::printqf>([](const long double* v) {
             int* tmp = (int*)v;
-            printf("0x%04x%04x%04x%04x", tmp[0], tmp[1], tmp[2], tmp[3]);
+            char buff[48];
+            _prints_l(buff, snprintf(buff, sizeof(buff), "0x%04x%04x%04x%04x", tmp[0], tmp[1], tmp[2], tmp[3]),
+                      sysio::cdt::output_stream_kind::std_out);
          });
       intrinsics::set_intrinsic<intrinsics::printn>([](uint64_t nm) {
             std::string s = sysio::name(nm).to_string();
-            prints_l(s.c_str(), s.length());
+            _prints_l(s.c_str(), s.length(), sysio::cdt::output_stream_kind::std_out);
          });
       intrinsics::set_intrinsic<intrinsics::printhex>([](const void* data, uint32_t len) {
             constexpr static uint32_t max_stack_buffer_size = 512;
@@ -157,7 +309,7 @@ extern "C" {
                ++b;
             }
 
-            prints_l(reinterpret_cast<const char*>(buffer), buffer_size);
+            _prints_l(reinterpret_cast<const char*>(buffer), buffer_size, sysio::cdt::output_stream_kind::std_out);
 
             if(max_stack_buffer_size < buffer_size) free(buffer);
          });
@@ -168,6 +320,8 @@ extern "C" {
       } else {
          ret_val = -1;
       }
+      write_cost_report(argc, argv);
+      sysio::cdt::flush_output();
       return ret_val;
    }
 
@@ -177,3 +331,29 @@ extern "C" {
       while (cnt--) *cp++ = 0;
    }
 }
+
+namespace sysio { namespace cdt {
+   void set_flush_policy(flush_policy policy) {
+      flush_output();
+      output_flush_policy = policy;
+   }
+
+   void flush_output() {
+      write_all(1, output_buffer, output_buffered);
+      output_buffered = 0;
+   }
+
+   void set_heap_limit(size_t bytes) {
+      sysio_assert(bytes <= heap_reserved, "native heap limit is larger than the reserved address space");
+      sysio_assert(bytes >= ___pages * wasm_page_size, "native heap limit is below the memory in use");
+      heap_max_bytes = bytes;
+   }
+
+   size_t heap_limit() {
+      return heap_max_bytes;
+   }
+
+   size_t heap_peak() {
+      return ___pages * wasm_page_size;
+   }
+}} //ns sysio::cdt
@@ -1,11 +1,19 @@
 .global _start
 .global ___putc
-.global _mmap
+.global ___reserve
+.global ___commit
+.global ___create_file
+.global ___write
+.global ___close
 .global setjmp
 .global longjmp
 .type _start,@function
 .type ___putc,@function
-.type _mmap,@function
+.type ___reserve,@function
+.type ___commit,@function
+.type ___create_file,@function
+.type ___write,@function
+.type ___close,@function
 .type setjmp,@function
 .type longjmp,@function
 
@@ -32,16 +40,39 @@ ___putc:
    mov %r8, %rbx
    ret
   
-_mmap:
-   mov $9, %eax
+___reserve:
+   mov %rdi, %rsi      # length
+   mov $9, %eax        # mmap
    mov $0, %rdi
-   mov $0x6400000, %rsi # 100Mb
-   mov $3, %rdx
-   mov $0x22, %r10
+   mov $0, %rdx        # PROT_NONE
+   mov $0x4022, %r10   # MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE
    mov $-1, %r8
    mov $0, %r9
    syscall
-   ret 
+   ret
+
+___commit:
+   mov $10, %eax       # mprotect
+   mov $3, %rdx        # PROT_READ | PROT_WRITE
+   syscall
+   ret
+
+___create_file:
+   mov $2, %eax      # open
+   mov $0x241, %esi  # O_WRONLY | O_CREAT | O_TRUNC
+   mov $0644, %edx
+   syscall
+   ret
+
+___write:
+   mov $1, %eax
+   syscall
+   ret
+
+___close:
+   mov $3, %eax
+   syscall
+   ret
 
 setjmp:
 	mov %rbx, 0(%rdi)
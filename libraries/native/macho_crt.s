@@ -1,6 +1,10 @@
 .global start
 .global ____putc
-.global __mmap
+.global ____reserve
+.global ____commit
+.global ____create_file
+.global ____write
+.global ____close
 .global _setjmp
 .global _longjmp
 
@@ -27,16 +31,51 @@ ____putc:
    mov %r8, %rbx
    ret
   
-__mmap:
-   mov $0x20000C5, %eax # mmap syscall 0xC5 or 197
+____reserve:
+   mov %rdi, %rsi        # length
+   mov $0x20000C5, %eax  # mmap syscall 0xC5 or 197
    mov $0, %rdi          # don't map
-   mov $0x640000000, %rsi  # size 100Mb 
-   mov $3, %rdx         
-   mov $0x1002, %r10
+   mov $0, %rdx          # PROT_NONE
+   mov $0x1002, %r10     # MAP_ANON | MAP_PRIVATE
    mov $-1, %r8
    mov $0, %r9
    syscall
-   ret 
+   jnc 1f
+   mov $-1, %rax
+1:
+   ret
+
+____commit:
+   mov $0x200004A, %eax  # mprotect syscall 0x4A
+   mov $3, %rdx          # PROT_READ | PROT_WRITE
+   syscall
+   jnc 1f
+   mov $-1, %rax
+1:
+   ret
+
+____create_file:
+   mov $0x2000005, %eax  # open syscall 0x5
+   mov $0x601, %esi      # O_WRONLY | O_CREAT | O_TRUNC
+   mov $0644, %edx
+   syscall
+   jnc 1f                # errors are returned with the carry set
+   mov $-1, %rax
+1:
+   ret
+
+____write:
+   mov $0x2000004, %eax  # write syscall 0x4
+   syscall
+   jnc 1f
+   mov $-1, %rax
+1:
+   ret
+
+____close:
+   mov $0x2000006, %eax  # close syscall 0x6
+   syscall
+   ret
 
 _setjmp:
 	mov %rbx, 0(%rdi)
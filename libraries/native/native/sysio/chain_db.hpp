@@ -0,0 +1,532 @@
+#pragma once
+#include "intrinsics.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <set>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace sysio { namespace native {
+
+   namespace _chain_db_detail {
+      // code, scope, table
+      using table_key = std::tuple<uint64_t, uint64_t, uint64_t>;
+
+      /**
+       * Hands out iterators the way the chain does: every object gets a non-negative handle that stays the same
+       * while the object exists, and every table a negative end iterator, -1 being reserved for "no table".
+       */
+      template<typename Table, typename Object>
+      class iterator_cache {
+         public:
+            int32_t cache_table( Table& table ) {
+               auto itr = _table_to_end.find( &table );
+               if( itr != _table_to_end.end() )
+                  return itr->second;
+               const int32_t ei = -int32_t(_end_to_table.size()) - 2;
+               _end_to_table.push_back( &table );
+               _table_to_end.emplace( &table, ei );
+               return ei;
+            }
+
+            Table* find_table_by_end_iterator( int32_t ei )const {
+               sysio::check( ei < -1, "not an end iterator" );
+               const size_t index = size_t(-(ei + 2));
+               sysio::check( index < _end_to_table.size(), "not a valid end iterator" );
+               return _end_to_table[index];
+            }
+
+            Object& get( int32_t itr )const {
+               sysio::check( itr != -1, "invalid iterator" );
+               sysio::check( itr >= 0, "dereference of end iterator" );
+               sysio::check( size_t(itr) < _objects.size(), "iterator out of range" );
+               sysio::check( _objects[itr] != nullptr, "dereference of deleted object" );
+               return *_objects[itr];
+            }
+
+            int32_t add( Object& obj ) {
+               auto itr = _object_to_iterator.find( &obj );
+               if( itr != _object_to_iterator.end() )
+                  return itr->second;
+               const int32_t result = int32_t(_objects.size());
+               _objects.push_back( &obj );
+               _object_to_iterator.emplace( &obj, result );
+               return result;
+            }
+
+            void remove( int32_t itr ) {
+               Object& obj = get( itr );
+               _object_to_iterator.erase( &obj );
+               _objects[itr] = nullptr;
+            }
+
+            void clear() {
+               _end_to_table.clear();
+               _table_to_end.clear();
+               _objects.clear();
+               _object_to_iterator.clear();
+            }
+
+         private:
+            std::vector<Table*>             _end_to_table;
+            std::map<const Table*, int32_t> _table_to_end;
+            std::vector<Object*>            _objects;
+            std::map<const Object*, int32_t> _object_to_iterator;
+      };
+
+      struct primary_table;
+
+      struct primary_object {
+         uint64_t          primary_key;
+         uint64_t          payer;
+         std::vector<char> value;
+         primary_table*    table;
+      };
+
+      struct primary_table {
+         uint64_t                           code = 0;
+         std::map<uint64_t, primary_object> rows;
+      };
+
+      /**
+       * Emulation of the `db_*_i64` intrinsics
+       */
+      class primary_index {
+         public:
+            int32_t store( uint64_t code, uint64_t scope, uint64_t table, uint64_t payer, uint64_t id, const void* data, uint32_t len ) {
+               auto& t = _tables[table_key{code, scope, table}];
+               t.code = code;
+               const char* bytes = static_cast<const char*>(data);
+               auto res = t.rows.emplace( id, primary_object{ id, payer, std::vector<char>(bytes, bytes + len), &t } );
+               sysio::check( res.second, "could not insert object, most likely a uniqueness constraint was violated" );
+               _cache.cache_table( t );
+               return _cache.add( res.first->second );
+            }
+
+            void update( uint64_t receiver, int32_t itr, uint64_t payer, const void* data, uint32_t len ) {
+               auto& obj = _cache.get( itr );
+               sysio::check( obj.table->code == receiver, "db access violation" );
+               if( payer )
+                  obj.payer = payer;
+               const char* bytes = static_cast<const char*>(data);
+               obj.value.assign( bytes, bytes + len );
+            }
+
+            void remove( uint64_t receiver, int32_t itr ) {
+               auto& obj = _cache.get( itr );
+               sysio::check( obj.table->code == receiver, "db access violation" );
+               primary_table* t = obj.table;
+               const uint64_t primary = obj.primary_key;
+               _cache.remove( itr );
+               t->rows.erase( primary );
+            }
+
+            int32_t get( int32_t itr, void* data, uint32_t len ) {
+               const auto& obj = _cache.get( itr );
+               const uint32_t size = uint32_t(obj.value.size());
+               if( len == 0 )
+                  return size;
+               const uint32_t copy_size = std::min( len, size );
+               memcpy( data, obj.value.data(), copy_size );
+               return copy_size;
+            }
+
+            int32_t next( int32_t itr, uint64_t& primary ) {
+               if( itr < -1 ) return -1; // cannot increment past the end iterator of a table
+               const auto& obj = _cache.get( itr );
+               primary_table* t = obj.table;
+               auto next = t->rows.upper_bound( obj.primary_key );
+               if( next == t->rows.end() )
+                  return _cache.cache_table( *t );
+               primary = next->first;
+               return _cache.add( next->second );
+            }
+
+            int32_t previous( int32_t itr, uint64_t& primary ) {
+               primary_table* t = nullptr;
+               typename std::map<uint64_t, primary_object>::iterator prev;
+               if( itr < -1 ) {
+                  t = _cache.find_table_by_end_iterator( itr );
+                  prev = t->rows.end();
+               } else {
+                  const auto& obj = _cache.get( itr );
+                  t = obj.table;
+                  prev = t->rows.find( obj.primary_key );
+               }
+               if( prev == t->rows.begin() )
+                  return -1;
+               --prev;
+               primary = prev->first;
+               return _cache.add( prev->second );
+            }
+
+            int32_t find( uint64_t code, uint64_t scope, uint64_t table, uint64_t id ) {
+               primary_table* t = find_table( code, scope, table );
+               if( !t ) return -1;
+               return cached( *t, t->rows.find( id ) );
+            }
+
+            int32_t lowerbound( uint64_t code, uint64_t scope, uint64_t table, uint64_t id ) {
+               primary_table* t = find_table( code, scope, table );
+               if( !t ) return -1;
+               return cached( *t, t->rows.lower_bound( id ) );
+            }
+
+            int32_t upperbound( uint64_t code, uint64_t scope, uint64_t table, uint64_t id ) {
+               primary_table* t = find_table( code, scope, table );
+               if( !t ) return -1;
+               return cached( *t, t->rows.upper_bound( id ) );
+            }
+
+            int32_t end( uint64_t code, uint64_t scope, uint64_t table ) {
+               primary_table* t = find_table( code, scope, table );
+               if( !t ) return -1;
+               return _cache.cache_table( *t );
+            }
+
+            void clear() {
+               _cache.clear();
+               _tables.clear();
+            }
+
+         private:
+            // the chain drops a table with its last row, so an empty table is reported as missing
+            primary_table* find_table( uint64_t code, uint64_t scope, uint64_t table ) {
+               auto itr = _tables.find( table_key{code, scope, table} );
+               if( itr == _tables.end() || itr->second.rows.empty() )
+                  return nullptr;
+               return &itr->second;
+            }
+
+            int32_t cached( primary_table& t, std::map<uint64_t, primary_object>::iterator itr ) {
+               const int32_t ei = _cache.cache_table( t );
+               if( itr == t.rows.end() )
+                  return ei;
+               return _cache.add( itr->second );
+            }
+
+            std::map<table_key, primary_table>              _tables;
+            iterator_cache<primary_table, primary_object> _cache;
+      };
+
+      template<typename Secondary>
+      struct secondary_table;
+
+      template<typename Secondary>
+      struct secondary_object {
+         uint64_t                    primary_key;
+         Secondary                   secondary_key;
+         uint64_t                    payer;
+         secondary_table<Secondary>* table;
+      };
+
+      template<typename Secondary>
+      struct secondary_table {
+         uint64_t                                        code = 0;
+         std::map<uint64_t, secondary_object<Secondary>> by_primary;
+         std::set<std::pair<Secondary, uint64_t>>        by_secondary;
+      };
+
+      /**
+       * Emulation of the `db_idx*` intrinsics of one secondary key type.
+       * Entries are ordered by secondary key and then by primary key, as on chain.
+       */
+      template<typename Secondary>
+      class secondary_index {
+         public:
+            using table_type  = secondary_table<Secondary>;
+            using object_type = secondary_object<Secondary>;
+
+            int32_t store( uint64_t code, uint64_t scope, uint64_t table, uint64_t payer, uint64_t id, const Secondary& secondary ) {
+               auto& t = _tables[table_key{code, scope, table}];
+               t.code = code;
+               auto res = t.by_primary.emplace( id, object_type{ id, secondary, payer, &t } );
+               sysio::check( res.second, "could not insert object, most likely a uniqueness constraint was violated" );
+               t.by_secondary.emplace( secondary, id );
+               _cache.cache_table( t );
+               return _cache.add( res.first->second );
+            }
+
+            void update( uint64_t receiver, int32_t itr, uint64_t payer, const Secondary& secondary ) {
+               auto& obj = _cache.get( itr );
+               sysio::check( obj.table->code == receiver, "db access violation" );
+               if( payer )
+                  obj.payer = payer;
+               obj.table->by_secondary.erase( { obj.secondary_key, obj.primary_key } );
+               obj.secondary_key = secondary;
+               obj.table->by_secondary.emplace( obj.secondary_key, obj.primary_key );
+            }
+
+            void remove( uint64_t receiver, int32_t itr ) {
+               auto& obj = _cache.get( itr );
+               sysio::check( obj.table->code == receiver, "db access violation" );
+               table_type* t = obj.table;
+               const uint64_t primary = obj.primary_key;
+               t->by_secondary.erase( { obj.secondary_key, primary } );
+               _cache.remove( itr );
+               t->by_primary.erase( primary );
+            }
+
+            int32_t find_primary( uint64_t code, uint64_t scope, uint64_t table, Secondary& secondary, uint64_t primary ) {
+               table_type* t = find_table( code, scope, table );
+               if( !t ) return -1;
+               const int32_t ei = _cache.cache_table( *t );
+               auto itr = t->by_primary.find( primary );
+               if( itr == t->by_primary.end() )
+                  return ei;
+               secondary = itr->second.secondary_key;
+               return _cache.add( itr->second );
+            }
+
+            int32_t find_secondary( uint64_t code, uint64_t scope, uint64_t table, const Secondary& secondary, uint64_t& primary ) {
+               table_type* t = find_table( code, scope, table );
+               if( !t ) return -1;
+               auto itr = t->by_secondary.lower_bound( { secondary, 0 } );
+               if( itr != t->by_secondary.end() && itr->first != secondary )
+                  itr = t->by_secondary.end();
+               return cached( *t, itr, nullptr, primary );
+            }
+
+            int32_t lowerbound( uint64_t code, uint64_t scope, uint64_t table, Secondary& secondary, uint64_t& primary ) {
+               table_type* t = find_table( code, scope, table );
+               if( !t ) return -1;
+               return cached( *t, t->by_secondary.lower_bound( { secondary, 0 } ), &secondary, primary );
+            }
+
+            int32_t upperbound( uint64_t code, uint64_t scope, uint64_t table, Secondary& secondary, uint64_t& primary ) {
+               table_type* t = find_table( code, scope, table );
+               if( !t ) return -1;
+               return cached( *t, t->by_secondary.upper_bound( { secondary, std::numeric_limits<uint64_t>::max() } ), &secondary, primary );
+            }
+
+            int32_t end( uint64_t code, uint64_t scope, uint64_t table ) {
+               table_type* t = find_table( code, scope, table );
+               if( !t ) return -1;
+               return _cache.cache_table( *t );
+            }
+
+            int32_t next( int32_t itr, uint64_t& primary ) {
+               if( itr < -1 ) return -1; // cannot increment past the end iterator of an index
+               const auto& obj = _cache.get( itr );
+               table_type* t = obj.table;
+               auto next = t->by_secondary.upper_bound( { obj.secondary_key, obj.primary_key } );
+               return cached( *t, next, nullptr, primary );
+            }
+
+            int32_t previous( int32_t itr, uint64_t& primary ) {
+               table_type* t = nullptr;
+               typename std::set<std::pair<Secondary, uint64_t>>::iterator prev;
+               if( itr < -1 ) {
+                  t = _cache.find_table_by_end_iterator( itr );
+                  prev = t->by_secondary.end();
+               } else {
+                  const auto& obj = _cache.get( itr );
+                  t = obj.table;
+                  prev = t->by_secondary.find( { obj.secondary_key, obj.primary_key } );
+               }
+               if( prev == t->by_secondary.begin() )
+                  return -1;
+               --prev;
+               return cached( *t, prev, nullptr, primary );
+            }
+
+            void clear() {
+               _cache.clear();
+               _tables.clear();
+            }
+
+         private:
+            table_type* find_table( uint64_t code, uint64_t scope, uint64_t table ) {
+               auto itr = _tables.find( table_key{code, scope, table} );
+               if( itr == _tables.end() || itr->second.by_primary.empty() )
+                  return nullptr;
+               return &itr->second;
+            }
+
+            int32_t cached( table_type& t, typename std::set<std::pair<Secondary, uint64_t>>::iterator itr, Secondary* secondary, uint64_t& primary ) {
+               const int32_t ei = _cache.cache_table( t );
+               if( itr == t.by_secondary.end() )
+                  return ei;
+               if( secondary )
+                  *secondary = itr->first;
+               primary = itr->second;
+               return _cache.add( t.by_primary.at( itr->second ) );
+            }
+
+            std::map<table_key, table_type>           _tables;
+            iterator_cache<table_type, object_type> _cache;
+      };
+   } // ns _chain_db_detail
+
+   /**
+    * In-memory emulation of the chain database for native unit tests.
+    *
+    * After `chain_db::install()` the `db_*_i64` and `db_idx*` intrinsics operate on tables kept in memory, with the
+    * iterator handles the chain would return, so `multi_index` and `singleton` work unchanged in native tests.
+    * Rows are stored on behalf of the receiver set with `set_receiver()`, which `current_receiver()` also returns.
+    *
+    * Example:
+    * @code
+    * sysio::native::chain_db::install();
+    * sysio::native::chain_db::get().set_receiver( "test"_n );
+    * accounts_table accounts( "test"_n, "test"_n.value );
+    * accounts.emplace( "test"_n, [](auto& a) { a.balance = 10; } );
+    * @endcode
+    */
+   class chain_db {
+      public:
+         /**
+          * Returns the database used by the installed intrinsics
+          */
+         static chain_db& get() {
+            static chain_db db;
+            return db;
+         }
+
+         /**
+          * Routes the database intrinsics and `current_receiver` to the in-memory database
+          */
+         static void install();
+
+         /**
+          * Sets the account that stores rows and that `current_receiver()` returns
+          */
+         void set_receiver( name receiver ) { _receiver = receiver; }
+         name get_receiver()const { return _receiver; }
+
+         /**
+          * Drops every table and invalidates every iterator
+          */
+         void clear() {
+            primary.clear();
+            idx64.clear();
+            idx128.clear();
+            idx256.clear();
+            idx_double.clear();
+            idx_long_double.clear();
+         }
+
+         _chain_db_detail::primary_index                                 primary;
+         _chain_db_detail::secondary_index<uint64_t>                     idx64;
+         _chain_db_detail::secondary_index<uint128_t>                    idx128;
+         _chain_db_detail::secondary_index<std::array<uint128_t, 2>>     idx256;
+         _chain_db_detail::secondary_index<double>                       idx_double;
+         _chain_db_detail::secondary_index<long double>                  idx_long_double;
+
+      private:
+         chain_db() = default;
+         chain_db( const chain_db& ) = delete;
+         chain_db& operator=( const chain_db& ) = delete;
+
+         name _receiver;
+   };
+
+#define SYSIO_CHAIN_DB_INSTALL_SECONDARY(IDX, TYPE) \
+   intrinsics::set_intrinsic<intrinsics::db_##IDX##_store>([](uint64_t scope, capi_name table, capi_name payer, uint64_t id, const TYPE* secondary) { \
+      auto& db = chain_db::get(); \
+      return db.IDX.store( db.get_receiver().value, scope, table, payer, id, *secondary ); }); \
+   intrinsics::set_intrinsic<intrinsics::db_##IDX##_update>([](int32_t iterator, capi_name payer, const TYPE* secondary) { \
+      auto& db = chain_db::get(); \
+      db.IDX.update( db.get_receiver().value, iterator, payer, *secondary ); }); \
+   intrinsics::set_intrinsic<intrinsics::db_##IDX##_remove>([](int32_t iterator) { \
+      auto& db = chain_db::get(); \
+      db.IDX.remove( db.get_receiver().value, iterator ); }); \
+   intrinsics::set_intrinsic<intrinsics::db_##IDX##_find_primary>([](capi_name code, uint64_t scope, capi_name table, TYPE* secondary, uint64_t primary) { \
+      return chain_db::get().IDX.find_primary( code, scope, table, *secondary, primary ); }); \
+   intrinsics::set_intrinsic<intrinsics::db_##IDX##_find_secondary>([](capi_name code, uint64_t scope, capi_name table, const TYPE* secondary, uint64_t* primary) { \
+      return chain_db::get().IDX.find_secondary( code, scope, table, *secondary, *primary ); }); \
+   intrinsics::set_intrinsic<intrinsics::db_##IDX##_lowerbound>([](capi_name code, uint64_t scope, capi_name table, TYPE* secondary, uint64_t* primary) { \
+      return chain_db::get().IDX.lowerbound( code, scope, table, *secondary, *primary ); }); \
+   intrinsics::set_intrinsic<intrinsics::db_##IDX##_upperbound>([](capi_name code, uint64_t scope, capi_name table, TYPE* secondary, uint64_t* primary) { \
+      return chain_db::get().IDX.upperbound( code, scope, table, *secondary, *primary ); }); \
+   intrinsics::set_intrinsic<intrinsics::db_##IDX##_end>([](capi_name code, uint64_t scope, capi_name table) { \
+      return chain_db::get().IDX.end( code, scope, table ); }); \
+   intrinsics::set_intrinsic<intrinsics::db_##IDX##_next>([](int32_t iterator, uint64_t* primary) { \
+      return chain_db::get().IDX.next( iterator, *primary ); }); \
+   intrinsics::set_intrinsic<intrinsics::db_##IDX##_previous>([](int32_t iterator, uint64_t* primary) { \
+      return chain_db::get().IDX.previous( iterator, *primary ); });
+
+   inline void chain_db::install() {
+      using key256 = std::array<uint128_t, 2>;
+
+      intrinsics::set_intrinsic<intrinsics::current_receiver>([]() {
+         return chain_db::get().get_receiver().value; });
+
+      intrinsics::set_intrinsic<intrinsics::db_store_i64>([](uint64_t scope, capi_name table, capi_name payer, uint64_t id, const void* data, uint32_t len) {
+         auto& db = chain_db::get();
+         return db.primary.store( db.get_receiver().value, scope, table, payer, id, data, len ); });
+      intrinsics::set_intrinsic<intrinsics::db_update_i64>([](int32_t iterator, capi_name payer, const void* data, uint32_t len) {
+         auto& db = chain_db::get();
+         db.primary.update( db.get_receiver().value, iterator, payer, data, len ); });
+      intrinsics::set_intrinsic<intrinsics::db_remove_i64>([](int32_t iterator) {
+         auto& db = chain_db::get();
+         db.primary.remove( db.get_receiver().value, iterator ); });
+      intrinsics::set_intrinsic<intrinsics::db_get_i64>([](int32_t iterator, const void* data, uint32_t len) {
+         return chain_db::get().primary.get( iterator, const_cast<void*>(data), len ); });
+      intrinsics::set_intrinsic<intrinsics::db_next_i64>([](int32_t iterator, uint64_t* primary) {
+         return chain_db::get().primary.next( iterator, *primary ); });
+      intrinsics::set_intrinsic<intrinsics::db_previous_i64>([](int32_t iterator, uint64_t* primary) {
+         return chain_db::get().primary.previous( iterator, *primary ); });
+      intrinsics::set_intrinsic<intrinsics::db_find_i64>([](capi_name code, uint64_t scope, capi_name table, uint64_t id) {
+         return chain_db::get().primary.find( code, scope, table, id ); });
+      intrinsics::set_intrinsic<intrinsics::db_lowerbound_i64>([](capi_name code, uint64_t scope, capi_name table, uint64_t id) {
+         return chain_db::get().primary.lowerbound( code, scope, table, id ); });
+      intrinsics::set_intrinsic<intrinsics::db_upperbound_i64>([](capi_name code, uint64_t scope, capi_name table, uint64_t id) {
+         return chain_db::get().primary.upperbound( code, scope, table, id ); });
+      intrinsics::set_intrinsic<intrinsics::db_end_i64>([](capi_name code, uint64_t scope, capi_name table) {
+         return chain_db::get().primary.end( code, scope, table ); });
+
+      SYSIO_CHAIN_DB_INSTALL_SECONDARY(idx64, uint64_t)
+      SYSIO_CHAIN_DB_INSTALL_SECONDARY(idx128, uint128_t)
+      SYSIO_CHAIN_DB_INSTALL_SECONDARY(idx_double, double)
+      SYSIO_CHAIN_DB_INSTALL_SECONDARY(idx_long_double, long double)
+
+      // 256-bit keys are passed as two 128-bit words
+      intrinsics::set_intrinsic<intrinsics::db_idx256_store>([](uint64_t scope, capi_name table, capi_name payer, uint64_t id, const uint128_t* data, uint32_t data_len) {
+         sysio::check( data_len == 2, "invalid size of secondary key array for idx256" );
+         auto& db = chain_db::get();
+         return db.idx256.store( db.get_receiver().value, scope, table, payer, id, key256{ data[0], data[1] } ); });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_update>([](int32_t iterator, capi_name payer, const uint128_t* data, uint32_t data_len) {
+         sysio::check( data_len == 2, "invalid size of secondary key array for idx256" );
+         auto& db = chain_db::get();
+         db.idx256.update( db.get_receiver().value, iterator, payer, key256{ data[0], data[1] } ); });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_remove>([](int32_t iterator) {
+         auto& db = chain_db::get();
+         db.idx256.remove( db.get_receiver().value, iterator ); });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_find_primary>([](capi_name code, uint64_t scope, capi_name table, uint128_t* data, uint32_t data_len, uint64_t primary) {
+         sysio::check( data_len == 2, "invalid size of secondary key array for idx256" );
+         key256 secondary{};
+         auto result = chain_db::get().idx256.find_primary( code, scope, table, secondary, primary );
+         if( result >= 0 ) { data[0] = secondary[0]; data[1] = secondary[1]; }
+         return result; });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_find_secondary>([](capi_name code, uint64_t scope, capi_name table, const uint128_t* data, uint32_t data_len, uint64_t* primary) {
+         sysio::check( data_len == 2, "invalid size of secondary key array for idx256" );
+         return chain_db::get().idx256.find_secondary( code, scope, table, key256{ data[0], data[1] }, *primary ); });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_lowerbound>([](capi_name code, uint64_t scope, capi_name table, uint128_t* data, uint32_t data_len, uint64_t* primary) {
+         sysio::check( data_len == 2, "invalid size of secondary key array for idx256" );
+         key256 secondary{ data[0], data[1] };
+         auto result = chain_db::get().idx256.lowerbound( code, scope, table, secondary, *primary );
+         if( result >= 0 ) { data[0] = secondary[0]; data[1] = secondary[1]; }
+         return result; });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_upperbound>([](capi_name code, uint64_t scope, capi_name table, uint128_t* data, uint32_t data_len, uint64_t* primary) {
+         sysio::check( data_len == 2, "invalid size of secondary key array for idx256" );
+         key256 secondary{ data[0], data[1] };
+         auto result = chain_db::get().idx256.upperbound( code, scope, table, secondary, *primary );
+         if( result >= 0 ) { data[0] = secondary[0]; data[1] = secondary[1]; }
+         return result; });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_end>([](capi_name code, uint64_t scope, capi_name table) {
+         return chain_db::get().idx256.end( code, scope, table ); });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_next>([](int32_t iterator, uint64_t* primary) {
+         return chain_db::get().idx256.next( iterator, *primary ); });
+      intrinsics::set_intrinsic<intrinsics::db_idx256_previous>([](int32_t iterator, uint64_t* primary) {
+         return chain_db::get().idx256.previous( iterator, *primary ); });
+   }
+
+#undef SYSIO_CHAIN_DB_INSTALL_SECONDARY
+
+}} //ns sysio::native
@@ -0,0 +1,112 @@
+#pragma once
+#include "intrinsics_def.hpp"
+#include "crt.hpp"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sysio { namespace native {
+
+   /**
+    * Work done by native code: host calls by intrinsic, bytes moved through the action data and database
+    * intrinsics, and the basic blocks executed when the code was compiled with `-fnative-count-blocks`.
+    */
+   struct execution_cost {
+      static constexpr size_t intrinsics_count = 0 INTRINSICS(COUNT_INTRINSIC);
+
+      uint64_t intrinsic_calls[intrinsics_count] = {};
+      uint64_t action_data_bytes = 0; // read with read_action_data
+      uint64_t db_read_bytes     = 0; // read with db_get_i64
+      uint64_t db_write_bytes    = 0; // written with db_store_i64 and db_update_i64
+      uint64_t basic_blocks      = 0;
+
+      uint64_t host_calls()const {
+         uint64_t total = 0;
+         for (uint64_t calls : intrinsic_calls)
+            total += calls;
+         return total;
+      }
+
+      /**
+       * The cost of the work done between two snapshots
+       */
+      friend execution_cost operator-(const execution_cost& a, const execution_cost& b) {
+         execution_cost d;
+         for (size_t i = 0; i < intrinsics_count; ++i)
+            d.intrinsic_calls[i] = a.intrinsic_calls[i] - b.intrinsic_calls[i];
+         d.action_data_bytes = a.action_data_bytes - b.action_data_bytes;
+         d.db_read_bytes     = a.db_read_bytes - b.db_read_bytes;
+         d.db_write_bytes    = a.db_write_bytes - b.db_write_bytes;
+         d.basic_blocks      = a.basic_blocks - b.basic_blocks;
+         return d;
+      }
+   };
+
+   /**
+    * Cost model of native tests. The counters are always on, each SYSIO_TEST starts from zero and records its cost
+    * when it ends, and the report of every test is written as JSON to the file named by the
+    * `SYSIO_NATIVE_COST_REPORT` environment variable when the test executable exits.
+    */
+   class cost_model {
+      public:
+         struct test_cost {
+            std::string    name;
+            bool           passed;
+            execution_cost cost;
+            size_t         heap_bytes; // growth of the heap peak over the test
+         };
+
+         static inline execution_cost         current;
+         static inline bool                   blocks_counted = false;
+         static inline std::vector<test_cost> tests;
+         static inline size_t                 heap_at_start = 0;
+
+         static constexpr const char* intrinsic_names[] = { INTRINSICS(GET_NAME) };
+
+         static void reset() {
+            current = execution_cost{};
+            heap_at_start = sysio::cdt::heap_peak();
+         }
+
+         static void record(const char* test_name, bool passed) {
+            tests.push_back(test_cost{test_name, passed, current, sysio::cdt::heap_peak() - heap_at_start});
+         }
+
+         /**
+          * The report of the recorded tests. Intrinsics which were not called are left out.
+          */
+         static std::string to_json() {
+            std::string json = "{\n  \"heap_peak_bytes\": " + std::to_string(sysio::cdt::heap_peak()) + ",\n";
+            json += "  \"heap_limit_bytes\": " + std::to_string(sysio::cdt::heap_limit()) + ",\n";
+            json += "  \"tests\": [";
+            for (size_t t = 0; t < tests.size(); ++t) {
+               const execution_cost& cost = tests[t].cost;
+               json += t ? ",\n" : "\n";
+               json += "    {\n      \"name\": \"" + tests[t].name + "\",\n";
+               json += std::string("      \"passed\": ") + (tests[t].passed ? "true" : "false") + ",\n";
+               json += "      \"host_calls\": " + std::to_string(cost.host_calls()) + ",\n";
+               json += "      \"intrinsic_calls\": {";
+               bool first = true;
+               for (size_t i = 0; i < execution_cost::intrinsics_count; ++i) {
+                  if (!cost.intrinsic_calls[i])
+                     continue;
+                  json += first ? "\n" : ",\n";
+                  json += std::string("        \"") + intrinsic_names[i] + "\": " + std::to_string(cost.intrinsic_calls[i]);
+                  first = false;
+               }
+               json += first ? "},\n" : "\n      },\n";
+               json += "      \"action_data_bytes\": " + std::to_string(cost.action_data_bytes) + ",\n";
+               json += "      \"db_read_bytes\": " + std::to_string(cost.db_read_bytes) + ",\n";
+               json += "      \"db_write_bytes\": " + std::to_string(cost.db_write_bytes) + ",\n";
+               json += "      \"heap_bytes\": " + std::to_string(tests[t].heap_bytes);
+               if (blocks_counted)
+                  json += ",\n      \"basic_blocks\": " + std::to_string(cost.basic_blocks);
+               json += "\n    }";
+            }
+            json += tests.empty() ? "]\n}\n" : "\n  ]\n}\n";
+            return json;
+         }
+   };
+
+}} //ns sysio::native
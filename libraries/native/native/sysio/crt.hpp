@@ -9,6 +9,37 @@ namespace sysio { namespace cdt {
       std_err,
       none
    };
+
+   /**
+    * When printed output is written to stdout. It is also flushed when the test executable exits, and the policy can
+    * be set with the `SYSIO_NATIVE_FLUSH` environment variable (`unbuffered`, `line` or `full`).
+    */
+   enum class flush_policy {
+      unbuffered, // written on every print
+      line,       // written on every print containing a newline
+      full        // written when the buffer fills up
+   };
+
+   void set_flush_policy(flush_policy policy);
+
+   /**
+    * Writes the buffered output to stdout
+    */
+   void flush_output();
+
+   /**
+    * The native heap reserves address space when the test executable starts and commits it as memory is grown, up to
+    * a limit of 4 GiB by default. The limit can be set with the `SYSIO_NATIVE_HEAP_LIMIT` environment variable, in
+    * bytes or with a K, M or G suffix, or raised at runtime within the reserved address space of at least 64 GiB.
+    */
+   void set_heap_limit(size_t bytes);
+   size_t heap_limit();
+
+   /**
+    * Bytes of heap grown so far, which is also the peak as the heap never shrinks
+    */
+   size_t heap_peak();
+
    class output_stream {
       static constexpr size_t initial_size = 1024 * 4;
       std::string output;
@@ -19,6 +50,7 @@ namespace sysio { namespace cdt {
       const char* get() const { return output.c_str(); }
       size_t index() const { return output.size(); }
       void push(char c) { output.push_back(c); }
+      void append(const char* cstr, size_t len) { output.append(cstr, len); }
       void clear() { output.clear(); }
    };
 }} //ns sysio::cdt
@@ -27,6 +59,7 @@ extern sysio::cdt::output_stream std_out;
 extern sysio::cdt::output_stream std_err;
 extern "C" jmp_buf* ___env_ptr;
 extern "C" char*    ___heap_ptr;
+extern "C" bool     ___capture_output;
 
 extern "C" {
    void __set_env_test();
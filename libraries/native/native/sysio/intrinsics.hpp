@@ -1,10 +1,14 @@
 #include <sysio/action.hpp>
 #include "intrinsics_def.hpp"
+#include "cost_model.hpp"
+
+#include <array>
+#include <memory>
 
 #pragma once
 
 namespace sysio { namespace native {
-   
+
    class intrinsics {
       public:
          static intrinsics& get() {
@@ -16,28 +20,86 @@ namespace sysio { namespace native {
             INTRINSICS(CREATE_ENUM)
             INTRINSICS_SIZE
          };
+         static_assert(INTRINSICS_SIZE == execution_cost::intrinsics_count, "cost model does not cover every intrinsic");
 
          INTRINSICS(GENERATE_TYPE_MAPPING)
-         std::tuple< INTRINSICS(GET_TYPE) std::function<void()> > funcs {
+         // constant initialized, calls index straight into the table without a guard or type erasure
+         static inline std::tuple< INTRINSICS(GET_TYPE) intrinsic_slot<void> > funcs {
             INTRINSICS(REGISTER_INTRINSIC)
-            std::function<void()>{[](){}}
+            intrinsic_slot<void>{}
          };
 
          template <intrinsic_name IN, typename... Args>
-         auto call(Args... args) -> decltype(std::get<IN>(intrinsics::get().funcs)(args...)) {
-            return std::get<IN>(intrinsics::get().funcs)(args...); 
+         static auto call(Args... args) -> decltype(std::get<IN>(funcs)(args...)) {
+            ++cost_model::current.intrinsic_calls[IN];
+            return std::get<IN>(funcs)(args...);
          }
 
+         /**
+          * Overrides an intrinsic with a function taking a context pointer, which is passed back on every call.
+          * The caller keeps the context alive.
+          */
+         template <intrinsic_name IN, typename R, typename... Args>
+         static void set_intrinsic(R(*func)(void*, Args...), void* context) {
+            auto& slot = std::get<IN>(funcs);
+            slot.func    = func;
+            slot.context = context;
+            // putting back the callable already in the slot keeps its copy
+            if (callables[IN].get() != context)
+               callables[IN].reset();
+         }
+
+         /**
+          * Overrides an intrinsic with any callable, or puts back an intrinsic saved with get_intrinsic(). The callable
+          * is copied into storage shared with the intrinsics saved while it is in place, and the copy is destroyed once
+          * neither the slot nor any of them refers to it.
+          */
          template <intrinsic_name IN, typename F>
          static void set_intrinsic(F&& func) {
-            auto& f = std::get<IN>(intrinsics::get().funcs);
-            std::get<IN>(intrinsics::get().funcs) = typename std::remove_reference<decltype(f)>::type {func};
+            auto& slot = std::get<IN>(funcs);
+            using slot_t = typename std::remove_reference<decltype(slot)>::type;
+            using callable_t = std::decay_t<F>;
+            if constexpr (is_saved_intrinsic<callable_t>::value) {
+               slot.func     = func.func;
+               slot.context  = func.context;
+               callables[IN] = func.owner;
+            } else {
+               auto copy = std::make_shared<callable_t>(std::forward<F>(func));
+               slot = make_slot(copy.get(), (slot_t*)nullptr);
+               callables[IN] = std::move(copy);
+            }
          }
-         
+
+         /**
+          * Saves an intrinsic, along with a share of the callable it was overridden with
+          */
          template <intrinsic_name IN>
-         static auto get_intrinsic() 
-               -> typename std::remove_reference<decltype(std::get<IN>(intrinsics::get().funcs))>::type {
-            return std::get<IN>(intrinsics::get().funcs);
+         static auto get_intrinsic() {
+            return save(std::get<IN>(funcs), callables[IN]);
+         }
+
+      private:
+         // the copies of the callables the intrinsics were overridden with, by intrinsic
+         static inline std::array<std::shared_ptr<void>, INTRINSICS_SIZE> callables;
+
+         template <typename R, typename... Args>
+         static saved_intrinsic<R, Args...> save(const intrinsic_slot<R, Args...>& slot, std::shared_ptr<void> owner) {
+            saved_intrinsic<R, Args...> saved;
+            saved.func    = slot.func;
+            saved.context = slot.context;
+            saved.owner   = std::move(owner);
+            return saved;
+         }
+
+         // the callable is called from a trampoline that can inline its body
+         template <typename F, typename R, typename... Args>
+         static intrinsic_slot<R, Args...> make_slot(F* func, intrinsic_slot<R, Args...>*) {
+            intrinsic_slot<R, Args...> slot;
+            slot.context = func;
+            slot.func    = [](void* context, Args... args) -> R {
+               return (*static_cast<F*>(context))(args...);
+            };
+            return slot;
          }
    };
 
@@ -15,6 +15,7 @@
 
 #include <type_traits>
 #include <functional>
+#include <memory>
 
 namespace sysio { namespace native {
    template <typename... Args, size_t... Is>
@@ -33,13 +34,42 @@ namespace sysio { namespace native {
        return std::tuple<std::decay_t<Args>...>{};
    }
 
+   /**
+    * Dispatch slot of one intrinsic: a plain function pointer and the context pointer passed to it.
+    * Slots are constant initialized to a function that asserts, so no code runs before the first override.
+    */
+   template <typename R, typename... Args>
+   struct intrinsic_slot {
+      using function_type = R(*)(void*, Args...);
+
+      function_type func    = &unsupported;
+      void*         context = nullptr;
+
+      R operator()(Args... args) const { return func(context, args...); }
+
+      static R unsupported(void*, Args...) {
+         sysio_assert(false, "unsupported intrinsic"); return (R)0;
+      }
+   };
+
+   /**
+    * An intrinsic saved with intrinsics::get_intrinsic(). It shares ownership of the callable the intrinsic was
+    * overridden with, so it stays callable after the intrinsic is overridden again, and it is put back with
+    * intrinsics::set_intrinsic().
+    */
+   template <typename R, typename... Args>
+   struct saved_intrinsic : intrinsic_slot<R, Args...> {
+      std::shared_ptr<void> owner;
+   };
+
+   template <typename T>
+   struct is_saved_intrinsic : std::false_type {};
+   template <typename R, typename... Args>
+   struct is_saved_intrinsic<saved_intrinsic<R, Args...>> : std::true_type {};
+
    template <typename R, typename Args, size_t... Is>
-   auto create_function(std::index_sequence<Is...>) {
-      return std::function<R(typename std::tuple_element<Is, Args>::type ...)>{
-         [](typename std::tuple_element<Is, Args>::type ...) {
-            sysio_assert(false, "unsupported intrinsic"); return (R)0;
-         }
-      };
+   constexpr auto create_function(std::index_sequence<Is...>) {
+      return intrinsic_slot<R, typename std::tuple_element<Is, Args>::type ...>{};
    }
 
 #define INTRINSICS(intrinsic_macro) \
@@ -179,6 +209,12 @@ intrinsic_macro(mod_exp)
 #define CREATE_ENUM(name) \
    name,
 
+#define GET_NAME(name) \
+   #name,
+
+#define COUNT_INTRINSIC(name) \
+   + 1
+
 #define GENERATE_TYPE_MAPPING(name) \
    struct __ ## name ## _types { \
       using deduced_full_ts = decltype(sysio::native::get_args_full(::name)); \
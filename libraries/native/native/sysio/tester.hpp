@@ -2,6 +2,7 @@
 #include <sysio/sysio.hpp>
 #include "crt.hpp"
 #include "intrinsics.hpp"
+#include "chain_db.hpp"
 #include <setjmp.h>
 #include <vector>
 
@@ -12,6 +13,13 @@ extern "C" bool ___earlier_unit_test_has_failed;
 inline void silence_output(bool t) {
    ___disable_output = t;
 }
+/**
+ * Whether printed output is kept for inspection outside of CHECK_PRINT and CHECK_ASSERT, which always capture it.
+ * Test suites printing a lot can turn it off so that the output is not also accumulated in memory.
+ */
+inline void capture_output(bool t) {
+   ___capture_output = t;
+}
 inline bool has_failed() {
    return ___has_failed;
 }
@@ -22,11 +30,14 @@ template <typename Pred, typename F, typename... Args>
 inline bool expect_assert(bool check, const std::string& li, Pred&& pred, F&& func, Args... args) {
    std_err.clear();
    __set_env_test();
+   const bool capture = ___capture_output;
+   ___capture_output = true;
    int ret = setjmp(*___env_ptr);
    bool disable_out = ___disable_output;
    if (ret == 0) {
       func(args...);
       __reset_env();
+      ___capture_output = capture;
       silence_output(false);
       if (!check)
          sysio::check(false, std::string("error : expect_assert, no assert {"+li+"}").c_str());
@@ -35,6 +46,7 @@ inline bool expect_assert(bool check, const std::string& li, Pred&& pred, F&& fu
       return false;
    }
    __reset_env();
+   ___capture_output = capture;
    bool passed = pred(std_err.get());
    std_err.clear();
    silence_output(false);
@@ -58,7 +70,10 @@ inline bool expect_assert(bool check, const std::string& li, const char (&expect
 template <typename Pred, typename F, typename... Args>
 inline bool expect_print(bool check, const std::string& li, Pred&& pred, F&& func, Args... args) {
    std_out.clear();
+   const bool capture = ___capture_output;
+   ___capture_output = true;
    func(args...);
+   ___capture_output = capture;
    bool passed = pred(std_out.get());
    std_out.clear();
    bool disable_out = ___disable_output;
@@ -106,6 +121,7 @@ inline bool expect_print(bool check, const std::string& li, const char (&expecte
    if ( X ## _ret == 0 ) \
       X(); \
    else { \
+      sysio::native::cost_model::record(#X, false); \
       bool ___original_disable_output = ___disable_output; \
       silence_output(false); \
       sysio::print("\033[1;37m", #X, " \033[0;37munit test \033[1;31mfailed\033[0m (aborted)\n"); \
@@ -117,9 +133,11 @@ inline bool expect_print(bool check, const std::string& li, const char (&expecte
    void X() { \
       static constexpr const char* __test_name = #X; \
       ___earlier_unit_test_has_failed = ___has_failed; \
-      ___has_failed = false;
+      ___has_failed = false; \
+      sysio::native::cost_model::reset();
 
 #define SYSIO_TEST_END \
+      sysio::native::cost_model::record(__test_name, !___has_failed); \
       bool ___original_disable_output = ___disable_output; \
       silence_output(false); \
       if (___has_failed) \
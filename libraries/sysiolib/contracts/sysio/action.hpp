@@ -6,6 +6,8 @@
 #include <cstdlib>
 #include <type_traits>
 
+#include "../../core/sysio/arena.hpp"
+#include "../../core/sysio/bytes_view.hpp"
 #include "../../core/sysio/serialize.hpp"
 #include "../../core/sysio/datastream.hpp"
 #include "../../core/sysio/name.hpp"
@@ -99,6 +101,22 @@ namespace sysio {
       return unpack<T>( buffer, size );
    }
 
+   /**
+    *  @ingroup action
+    *  @param a - The arena the raw action data is read into
+    *  @return Unpacked action data casted as T.
+    *
+    *  Same as `unpack_action_data<T>()` but takes the buffer for the raw action data from an @ref arena
+    *  instead of the stack or the heap, so it is released with the arena's other temporaries.
+    */
+   template<typename T>
+   T unpack_action_data( arena& a ) {
+      size_t size = internal_use_do_not_use::action_data_size();
+      char* buffer = (char*)a.allocate( size, 1 );
+      internal_use_do_not_use::read_action_data( buffer, size );
+      return unpack<T>( buffer, size );
+   }
+
    /**
     *  Add the specified account to set of accounts to be notified
     *
@@ -313,6 +331,53 @@ namespace sysio {
       return internal_use_do_not_use::is_account( n.value );
    }
 
+   namespace detail {
+
+      /// @cond INTERNAL
+
+      // payload bytes that are already serialized and are written as they are
+      struct raw_payload {
+         const char* data;
+         size_t      size;
+      };
+
+      template<typename Stream>
+      inline datastream<Stream>& operator<<( datastream<Stream>& ds, const raw_payload& p ) {
+         ds.write( p.data, p.size );
+         return ds;
+      }
+
+      // Serializes the action header and the payload straight into one buffer and hands it to the host,
+      // so the payload is packed once and no intermediate action or byte vector is built.
+      // The buffer comes from the arena when one is given, otherwise from the stack unless it is large.
+      template<typename T>
+      void send_packed_action( bool context_free, name account, name act, const std::vector<permission_level>& auths,
+                               const T& payload, arena* a = nullptr ) {
+         if ( context_free )
+            sysio::check( auths.size() == 0, "context free actions cannot have authorizations");
+
+         const size_t payload_size = pack_size( payload );
+         datastream<size_t> ps;
+         ps << account << act << auths << unsigned_int( payload_size );
+         const size_t size = ps.tellp() + payload_size;
+
+         constexpr size_t max_stack_buffer_size = 512;
+         const bool on_heap = !a && max_stack_buffer_size < size;
+         char* buffer = (char*)( a ? a->allocate( size, 1 ) : on_heap ? malloc( size ) : alloca( size ) );
+         unchecked_datastream ds( buffer, size );
+         ds << account << act << auths << unsigned_int( payload_size ) << payload;
+
+         if ( context_free )
+            internal_use_do_not_use::send_context_free_inline( buffer, size );
+         else
+            internal_use_do_not_use::send_inline( buffer, size );
+         if ( on_heap )
+            free( buffer );
+      }
+
+      /// @endcond
+   }
+
    /**
     *  This is the packed representation of an action along with
     *  meta-data about the authorization levels.
@@ -381,8 +446,16 @@ namespace sysio {
        * Send the action as inline action
        */
       void send() const {
-         auto serialize = pack(*this);
-         internal_use_do_not_use::send_inline(serialize.data(), serialize.size());
+         detail::send_packed_action( false, account, name, authorization, detail::raw_payload{ data.data(), data.size() } );
+      }
+
+      /**
+       * Send the action as inline action, serializing it into a buffer from the given arena
+       *
+       * @param a - The arena that holds the serialized action
+       */
+      void send( arena& a ) const {
+         detail::send_packed_action( false, account, name, authorization, detail::raw_payload{ data.data(), data.size() }, &a );
       }
 
       /**
@@ -391,9 +464,17 @@ namespace sysio {
        * @pre This action should not contain any authorizations
        */
       void send_context_free() const {
-         sysio::check( authorization.size() == 0, "context free actions cannot have authorizations");
-         auto serialize = pack(*this);
-         internal_use_do_not_use::send_context_free_inline(serialize.data(), serialize.size());
+         detail::send_packed_action( true, account, name, authorization, detail::raw_payload{ data.data(), data.size() } );
+      }
+
+      /**
+       * Send the action as inline context free action, serializing it into a buffer from the given arena
+       *
+       * @param a - The arena that holds the serialized action
+       * @pre This action should not contain any authorizations
+       */
+      void send_context_free( arena& a ) const {
+         detail::send_packed_action( true, account, name, authorization, detail::raw_payload{ data.data(), data.size() }, &a );
       }
 
       /**
@@ -539,12 +620,20 @@ namespace sysio {
       }
       template <typename... Args>
       void send(Args&&... args)const {
-         to_action(std::forward<Args>(args)...).send();
+         static_assert(detail::type_check<Action, Args...>());
+         detail::send_packed_action(false, code_name, action_name, permissions, detail::deduced<Action>{std::forward<Args>(args)...});
+      }
+
+      template <typename... Args>
+      void send(arena& a, Args&&... args)const {
+         static_assert(detail::type_check<Action, Args...>());
+         detail::send_packed_action(false, code_name, action_name, permissions, detail::deduced<Action>{std::forward<Args>(args)...}, &a);
       }
 
       template <typename... Args>
       void send_context_free(Args&&... args)const {
-         to_action(std::forward<Args>(args)...).send_context_free();
+         static_assert(detail::type_check<Action, Args...>());
+         detail::send_packed_action(true, code_name, action_name, permissions, detail::deduced<Action>{std::forward<Args>(args)...});
       }
 
    };
@@ -578,20 +667,31 @@ namespace sysio {
 
       template <size_t Variant, typename... Args>
       action to_action(Args&&... args)const {
-         static_assert(detail::type_check<detail::get_nth<Variant, Actions...>::value, Args...>());
-         unsigned_int var = Variant;
-         return action(permissions, code_name, action_name, std::tuple_cat(std::make_tuple(var), detail::deduced<detail::get_nth<Variant, Actions...>::value>{std::forward<Args>(args)...}));
+         return action(permissions, code_name, action_name, payload<Variant>(std::forward<Args>(args)...));
       }
 
 
       template <size_t Variant, typename... Args>
       void send(Args&&... args)const {
-         to_action<Variant>(std::forward<Args>(args)...).send();
+         detail::send_packed_action(false, code_name, action_name, permissions, payload<Variant>(std::forward<Args>(args)...));
+      }
+
+      template <size_t Variant, typename... Args>
+      void send(arena& a, Args&&... args)const {
+         detail::send_packed_action(false, code_name, action_name, permissions, payload<Variant>(std::forward<Args>(args)...), &a);
       }
 
       template <size_t Variant, typename... Args>
       void send_context_free(Args&&... args) const {
-         to_action<Variant>(std::forward<Args>(args)...).send_context_free();
+         detail::send_packed_action(true, code_name, action_name, permissions, payload<Variant>(std::forward<Args>(args)...));
+      }
+
+   private:
+      template <size_t Variant, typename... Args>
+      static auto payload(Args&&... args) {
+         static_assert(detail::type_check<detail::get_nth<Variant, Actions...>::value, Args...>());
+         unsigned_int var = Variant;
+         return std::tuple_cat(std::make_tuple(var), detail::deduced<detail::get_nth<Variant, Actions...>::value>{std::forward<Args>(args)...});
       }
 
    };
@@ -600,7 +700,7 @@ namespace sysio {
    void dispatch_inline( name code, name act,
                          std::vector<permission_level> perms,
                          std::tuple<Args...> args ) {
-      action( perms, code, act, std::move(args) ).send();
+      detail::send_packed_action( false, code, act, perms, args );
    }
 
    template<typename, name::raw>
@@ -84,6 +84,7 @@ namespace sysio {
       };
 
       std::apply( f2, args );
+      // borrowed arguments such as std::string_view point into the buffer, so it is only released here
       if ( max_stack_buffer_size < size ) {
          free(buffer);
       }
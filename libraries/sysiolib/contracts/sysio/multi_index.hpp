@@ -20,6 +20,7 @@
 #include <limits>
 #include <algorithm>
 #include <memory>
+#include <new>
 
 /**
  * @defgroup multiindex Multi Index Table
@@ -338,8 +339,435 @@ namespace _multi_index_detail {
    inline uint64_t to_raw_key(PK pk) { return pk; }
    inline uint64_t to_raw_key(sysio::name pk) { return pk.value; }
 
+   /**
+    * Open addressing hash index mapping a 64-bit key to a slot of the row cache.
+    * Uses linear probing with backward shift deletion, so erasing never leaves tombstones behind.
+    */
+   class cache_index {
+      public:
+         static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+         uint32_t find( uint64_t key )const {
+            if( _size == 0 )
+               return npos;
+            for( size_t i = bucket( key ); ; i = (i + 1) & mask() ) {
+               const auto& s = _slots[i];
+               if( s.value == npos ) return npos;
+               if( s.key == key )    return s.value;
+            }
+         }
+
+         void insert( uint64_t key, uint32_t value ) {
+            if( (_size + 1) * 4 > _slots.size() * 3 )
+               grow();
+            place( key, value );
+            ++_size;
+         }
+
+         void assign( uint64_t key, uint32_t value ) {
+            for( size_t i = bucket( key ); _slots[i].value != npos; i = (i + 1) & mask() ) {
+               if( _slots[i].key == key ) {
+                  _slots[i].value = value;
+                  return;
+               }
+            }
+         }
+
+         void erase( uint64_t key ) {
+            if( _size == 0 )
+               return;
+            size_t i = bucket( key );
+            for( ; _slots[i].key != key; i = (i + 1) & mask() ) {
+               if( _slots[i].value == npos ) return;
+            }
+            if( _slots[i].value == npos )
+               return;
+
+            // shift back every displaced entry that would otherwise become unreachable
+            for( size_t j = (i + 1) & mask(); _slots[j].value != npos; j = (j + 1) & mask() ) {
+               size_t home = bucket( _slots[j].key );
+               bool in_range = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+               if( !in_range ) {
+                  _slots[i] = _slots[j];
+                  i = j;
+               }
+            }
+            _slots[i].value = npos;
+            --_size;
+         }
+
+      private:
+         struct slot {
+            uint64_t key   = 0;
+            uint32_t value = npos;
+         };
+
+         size_t mask()const { return _slots.size() - 1; }
+
+         size_t bucket( uint64_t key )const {
+            // Fibonacci hashing; primary keys and iterators tend to be sequential
+            return (key * 0x9E3779B97F4A7C15ULL) >> (64 - _shift);
+         }
+
+         void place( uint64_t key, uint32_t value ) {
+            size_t i = bucket( key );
+            while( _slots[i].value != npos )
+               i = (i + 1) & mask();
+            _slots[i].key   = key;
+            _slots[i].value = value;
+         }
+
+         void grow() {
+            std::vector<slot> previous( _slots.empty() ? 16 : _slots.size() * 2 );
+            _shift = _slots.empty() ? 4 : _shift + 1;
+            previous.swap( _slots );
+            for( const auto& s : previous ) {
+               if( s.value != npos )
+                  place( s.key, s.value );
+            }
+         }
+
+         std::vector<slot> _slots;
+         uint32_t          _size  = 0;
+         uint32_t          _shift = 0;
+   };
+
+   /**
+    * Storage for the rows cached by a multi_index.
+    * Rows are constructed in chunks of slots that never move, so references to them stay valid until the row is
+    * erased, and the slot of an erased row is reused by the next row. Chunks double in size from a few rows up to
+    * about 16 KiB, so walking a table costs a handful of allocations instead of one per row.
+    */
+   template<typename Item>
+   class item_pool {
+      public:
+         item_pool() = default;
+
+         item_pool( item_pool&& o )
+         : _chunks(std::move(o._chunks)), _free(std::exchange(o._free, nullptr)), _next(std::exchange(o._next, nullptr)),
+           _end(std::exchange(o._end, nullptr)), _chunk_size(std::exchange(o._chunk_size, 0)) {}
+
+         item_pool& operator=( item_pool&& o ) {
+            _chunks     = std::move(o._chunks);
+            _free       = std::exchange(o._free, nullptr);
+            _next       = std::exchange(o._next, nullptr);
+            _end        = std::exchange(o._end, nullptr);
+            _chunk_size = std::exchange(o._chunk_size, 0);
+            return *this;
+         }
+
+         template<typename... Args>
+         Item* create( Args&&... args ) {
+            return new (allocate()) Item( std::forward<Args>(args)... );
+         }
+
+         void destroy( Item* i ) {
+            i->~Item();
+            slot* s = reinterpret_cast<slot*>(i);
+            s->next = _free;
+            _free   = s;
+         }
+
+      private:
+         union slot {
+            slot* next;
+            alignas(Item) unsigned char storage[sizeof(Item)];
+         };
+
+         static constexpr size_t first_chunk = 4;
+         static constexpr size_t max_chunk   = std::max<size_t>( first_chunk, 16 * 1024 / sizeof(slot) );
+
+         void* allocate() {
+            if( _free ) {
+               slot* s = _free;
+               _free = s->next;
+               return s;
+            }
+            if( _next == _end ) {
+               _chunk_size = _chunks.empty() ? first_chunk : std::min( _chunk_size * 2, max_chunk );
+               _chunks.emplace_back( new slot[_chunk_size] );
+               _next = _chunks.back().get();
+               _end  = _next + _chunk_size;
+            }
+            return _next++;
+         }
+
+         std::vector<std::unique_ptr<slot[]>> _chunks;
+         slot*  _free       = nullptr;
+         slot*  _next       = nullptr;
+         slot*  _end        = nullptr;
+         size_t _chunk_size = 0;
+   };
+
+   /**
+    * Cache of the rows loaded by a multi_index, indexed by both primary key and primary iterator.
+    * The rows live in an item_pool, so references handed out to callers stay valid until the row is erased.
+    */
+   template<typename Item>
+   class item_cache {
+      public:
+         item_cache() = default;
+
+         item_cache( item_cache&& o )
+         : _pool(std::move(o._pool)), _entries(std::exchange(o._entries, {})),
+           _by_primary_key(std::move(o._by_primary_key)), _by_primary_itr(std::move(o._by_primary_itr)) {}
+
+         item_cache& operator=( item_cache&& o ) {
+            clear();
+            _pool           = std::move(o._pool);
+            _entries        = std::exchange(o._entries, {});
+            _by_primary_key = std::move(o._by_primary_key);
+            _by_primary_itr = std::move(o._by_primary_itr);
+            return *this;
+         }
+
+         ~item_cache() {
+            clear();
+         }
+
+         Item* find_by_primary_key( uint64_t pk )const {
+            auto slot = _by_primary_key.find( pk );
+            return slot == cache_index::npos ? nullptr : _entries[slot]._item;
+         }
+
+         Item* find_by_primary_itr( int32_t itr )const {
+            auto slot = _by_primary_itr.find( itr_key(itr) );
+            return slot == cache_index::npos ? nullptr : _entries[slot]._item;
+         }
+
+         /**
+          * Constructs a row in the pool, to be added with insert() once its primary key and iterator are known
+          */
+         template<typename... Args>
+         Item* create( Args&&... args ) {
+            return _pool.create( std::forward<Args>(args)... );
+         }
+
+         Item& insert( Item* i, uint64_t pk, int32_t pitr ) {
+            uint32_t slot = _entries.size();
+            _entries.emplace_back( i, pk, pitr );
+            _by_primary_key.insert( pk, slot );
+            _by_primary_itr.insert( itr_key(pitr), slot );
+            return *i;
+         }
+
+         bool erase( uint64_t pk ) {
+            auto slot = _by_primary_key.find( pk );
+            if( slot == cache_index::npos )
+               return false;
+
+            _by_primary_key.erase( pk );
+            _by_primary_itr.erase( itr_key(_entries[slot]._primary_itr) );
+            _pool.destroy( _entries[slot]._item );
+
+            // move the last entry into the freed slot to keep the storage dense
+            if( slot != _entries.size() - 1 ) {
+               _entries[slot] = _entries.back();
+               _by_primary_key.assign( _entries[slot]._primary_key, slot );
+               _by_primary_itr.assign( itr_key(_entries[slot]._primary_itr), slot );
+            }
+            _entries.pop_back();
+            return true;
+         }
+
+         size_t size()const { return _entries.size(); }
+
+      private:
+         struct entry {
+            entry( Item* i, uint64_t pk, int32_t pitr )
+            : _item(i), _primary_key(pk), _primary_itr(pitr) {}
+
+            Item*    _item;
+            uint64_t _primary_key;
+            int32_t  _primary_itr;
+         };
+
+         static uint64_t itr_key( int32_t itr ) { return static_cast<uint32_t>(itr); }
+
+         void clear() {
+            for( auto& e : _entries )
+               _pool.destroy( e._item );
+            _entries.clear();
+            _by_primary_key = cache_index();
+            _by_primary_itr = cache_index();
+         }
+
+         item_pool<Item>    _pool;
+         std::vector<entry> _entries;
+         cache_index        _by_primary_key;
+         cache_index        _by_primary_itr;
+   };
+
+   template<typename T, typename = void>
+   struct has_serialized_members : std::false_type {};
+
+   template<typename T>
+   struct has_serialized_members<T, std::void_t<decltype(T::_syslib_for_each_member(std::declval<void(*)(int)>()))>> : std::true_type {};
+
+   template<typename T>
+   struct is_primitive_vector : std::false_type {};
+
+   template<typename T, typename A>
+   struct is_primitive_vector<std::vector<T, A>> : std::bool_constant<_datastream_detail::is_primitive<T>()> {};
+
+   template<typename T>
+   struct fixed_bytes_size : std::integral_constant<size_t, 0> {};
+
+   template<size_t Size>
+   struct fixed_bytes_size<fixed_bytes<Size>> : std::integral_constant<size_t, Size> {};
+
+   template<typename C, typename F>
+   F member_type_of( F C::* );
+
+   /**
+    * Moves the stream past one serialized value of type F, reading as little of it as possible
+    */
+   template<typename F>
+   void skip_value( datastream<const char*>& ds ) {
+      if constexpr( _datastream_detail::is_primitive<F>() ) {
+         ds.skip( sizeof(F) );
+      } else if constexpr( std::is_same_v<F, std::string> ) {
+         unsigned_int size;
+         ds >> size;
+         ds.skip( size.value );
+      } else if constexpr( fixed_bytes_size<F>::value > 0 ) {
+         ds.skip( fixed_bytes_size<F>::value );
+      } else if constexpr( is_primitive_vector<F>::value ) {
+         unsigned_int size;
+         ds >> size;
+         ds.skip( size.value * sizeof(typename F::value_type) );
+      } else if constexpr( has_serialized_members<F>::value ) {
+         F::_syslib_for_each_member( [&]( auto member ) {
+            skip_value<decltype(member_type_of(member))>( ds );
+         });
+      } else {
+         F value;
+         ds >> value;
+      }
+   }
+
 }
 
+/**
+ * Read-only view of a table row that keeps the row in its serialized form and decodes only the fields that are read.
+ *
+ * Fields are located by walking the members listed in the `SYSLIB_SERIALIZE` of the row type and skipping the
+ * ones before the requested field; rows without `SYSLIB_SERIALIZE` are decoded in full on the first read.
+ * The row bytes are fetched from the database on the first read, so checking that a row exists costs a single lookup.
+ * When the row is already in the multi_index cache the view reads the cached object instead, and it must then not
+ * outlive the erasure of that row.
+ *
+ * @ingroup multiindex
+ * @tparam T - type of the row
+ *
+ * Example:
+ *
+ * @code
+ * auto row = table.find_view( id );
+ * if( row )
+ *    print( row.get<&record::balance>() );
+ * @endcode
+ */
+template<typename T>
+class row_view {
+   public:
+      row_view() = default;
+
+      /**
+       * Constructs a view over a row that is already deserialized
+       *
+       * @param obj - The row, it must outlive the view
+       */
+      explicit row_view( const T* obj ) : _cached(obj) {}
+
+      /**
+       * Constructs a view over the row behind a primary table iterator
+       *
+       * @param primary_itr - The database iterator of the row, negative if there is no row
+       */
+      explicit row_view( int32_t primary_itr ) : _primary_itr(primary_itr) {}
+
+      /**
+       * Constructs a view over an already serialized row
+       *
+       * @param bytes - The serialized row
+       */
+      explicit row_view( std::vector<char> bytes ) : _bytes(std::move(bytes)), _loaded(true) {}
+
+      /**
+       * Checks whether the view refers to a row
+       */
+      explicit operator bool()const { return _cached || _loaded || _primary_itr >= 0; }
+
+      /**
+       * Decodes a single field of the row
+       *
+       * @tparam Member - Pointer to the member to read, e.g. `&record::balance`
+       * @return The value of the field
+       */
+      template<auto Member>
+      auto get()const {
+         using field_type = decltype(_multi_index_detail::member_type_of(Member));
+         sysio::check( bool(*this), "cannot read a field of an empty row view" );
+         if( _cached )
+            return field_type( _cached->*Member );
+
+         if constexpr( _multi_index_detail::has_serialized_members<T>::value ) {
+            datastream<const char*> ds = stream();
+            field_type result{};
+            bool found = false;
+            T::_syslib_for_each_member( [&]( auto member ) {
+               if( found )
+                  return;
+               if constexpr( std::is_same_v<decltype(member), decltype(Member)> ) {
+                  if( member == Member ) {
+                     ds >> result;
+                     found = true;
+                     return;
+                  }
+               }
+               _multi_index_detail::skip_value<decltype(_multi_index_detail::member_type_of(member))>( ds );
+            });
+            sysio::check( found, "member is not serialized by the row type" );
+            return result;
+         } else {
+            return field_type( value().*Member );
+         }
+      }
+
+      /**
+       * Decodes the whole row
+       *
+       * @return The row
+       */
+      T value()const {
+         sysio::check( bool(*this), "cannot read an empty row view" );
+         if( _cached )
+            return *_cached;
+         T result;
+         datastream<const char*> ds = stream();
+         ds >> result;
+         return result;
+      }
+
+   private:
+      datastream<const char*> stream()const {
+         if( !_loaded ) {
+            auto size = internal_use_do_not_use::db_get_i64( _primary_itr, nullptr, 0 );
+            sysio::check( size >= 0, "error reading iterator" );
+            _bytes.resize( size_t(size) );
+            internal_use_do_not_use::db_get_i64( _primary_itr, _bytes.data(), uint32_t(size) );
+            _loaded = true;
+         }
+         return { _bytes.data(), _bytes.size() };
+      }
+
+      const T*                  _cached      = nullptr;
+      int32_t                   _primary_itr = -1;
+      mutable std::vector<char> _bytes;
+      mutable bool              _loaded      = false;
+};
+
 /**
  * The indexed_by struct is used to instantiate the indices for the Multi-Index table. In SYSIO, up to 16 secondary indices can be specified.
  *
@@ -473,19 +901,10 @@ class multi_index
          const multi_index* __idx;
          int32_t            __primary_itr;
          int32_t            __iters[sizeof...(Indices)+(sizeof...(Indices)==0)];
+         int32_t            __dirty_slot = -1;
       };
 
-      struct item_ptr
-      {
-         item_ptr(std::unique_ptr<item>&& i, uint64_t pk, int32_t pitr)
-         : _item(std::move(i)), _primary_key(pk), _primary_itr(pitr) {}
-
-         std::unique_ptr<item> _item;
-         uint64_t              _primary_key;
-         int32_t               _primary_itr;
-      };
-
-      mutable std::vector<item_ptr> _items_vector;
+      mutable _multi_index_detail::item_cache<item> _items;
 
       template<name::raw IndexName, typename Extractor, uint64_t Number, bool IsConst>
       struct index {
@@ -601,6 +1020,127 @@ class multi_index
                   const item*  _item;
             }; /// struct multi_index::index::const_iterator
 
+            /**
+             * Iterator over the entries of a secondary index that does not load rows while it moves.
+             *
+             * Each step costs a single secondary index host call and yields the primary key of the entry;
+             * the secondary key is read on request and the row is loaded, through the table cache, only when the
+             * iterator is dereferenced.
+             */
+            struct key_iterator : public std::iterator<std::bidirectional_iterator_tag, const T> {
+               public:
+                  friend bool operator == ( const key_iterator& a, const key_iterator& b ) {
+                     return a._itr == b._itr;
+                  }
+                  friend bool operator != ( const key_iterator& a, const key_iterator& b ) {
+                     return a._itr != b._itr;
+                  }
+
+                  /**
+                   * Returns the primary key of the entry without loading the row
+                   */
+                  uint64_t primary_key()const {
+                     sysio::check( _itr >= 0, "cannot read the key of an end iterator" );
+                     return _primary;
+                  }
+
+                  /**
+                   * Returns the secondary key of the entry without loading the row
+                   */
+                  const secondary_key_type& secondary_key()const {
+                     using namespace _multi_index_detail;
+
+                     sysio::check( _itr >= 0, "cannot read the key of an end iterator" );
+                     if( !_has_secondary ) {
+                        secondary_index_db_functions<secondary_key_type>::db_idx_find_primary( _idx->get_code().value, _idx->get_scope(), _idx->name(), _primary, _secondary );
+                        _has_secondary = true;
+                     }
+                     return _secondary;
+                  }
+
+                  const T& operator*()const {
+                     sysio::check( _itr >= 0, "cannot dereference end iterator" );
+                     const T& obj = *_idx->_multidx->find( _primary );
+                     auto& mi = const_cast<item&>( static_cast<const item&>(obj) );
+                     mi.__iters[Number] = _itr;
+                     return obj;
+                  }
+                  const T* operator->()const { return &**this; }
+
+                  key_iterator operator++(int){
+                     key_iterator result(*this);
+                     ++(*this);
+                     return result;
+                  }
+
+                  key_iterator operator--(int){
+                     key_iterator result(*this);
+                     --(*this);
+                     return result;
+                  }
+
+                  key_iterator& operator++() {
+                     using namespace _multi_index_detail;
+
+                     sysio::check( _itr >= 0, "cannot increment end iterator" );
+
+                     uint64_t next_pk = 0;
+                     auto next_itr = secondary_index_db_functions<secondary_key_type>::db_idx_next( _itr, &next_pk );
+                     set( next_itr, next_pk );
+                     return *this;
+                  }
+
+                  key_iterator& operator--() {
+                     using namespace _multi_index_detail;
+
+                     uint64_t prev_pk = 0;
+                     int32_t  prev_itr = -1;
+
+                     if( _itr < 0 ) {
+                        auto ei = secondary_index_db_functions<secondary_key_type>::db_idx_end(_idx->get_code().value, _idx->get_scope(), _idx->name());
+                        sysio::check( ei != -1, "cannot decrement end iterator when the index is empty" );
+                        prev_itr = secondary_index_db_functions<secondary_key_type>::db_idx_previous( ei , &prev_pk );
+                        sysio::check( prev_itr >= 0, "cannot decrement end iterator when the index is empty" );
+                     } else {
+                        prev_itr = secondary_index_db_functions<secondary_key_type>::db_idx_previous( _itr, &prev_pk );
+                        sysio::check( prev_itr >= 0, "cannot decrement iterator at beginning of index" );
+                     }
+
+                     set( prev_itr, prev_pk );
+                     return *this;
+                  }
+
+                  key_iterator():_idx(nullptr){}
+               private:
+                  friend struct index;
+                  key_iterator( const index* idx, int32_t itr = -1, uint64_t primary = 0 )
+                  : _idx(idx) { set( itr, primary ); }
+
+                  // all end positions are stored as -1 so that they compare equal
+                  void set( int32_t itr, uint64_t primary ) {
+                     _itr           = itr < 0 ? -1 : itr;
+                     _primary       = primary;
+                     _has_secondary = false;
+                  }
+
+                  const index*               _idx;
+                  int32_t                    _itr = -1;
+                  uint64_t                   _primary = 0;
+                  mutable secondary_key_type _secondary{};
+                  mutable bool               _has_secondary = false;
+            }; /// struct multi_index::index::key_iterator
+
+            /**
+             * A pair of key iterators delimiting part of a secondary index, usable in a range-based for loop
+             */
+            struct key_range {
+               key_iterator first;
+               key_iterator last;
+
+               key_iterator begin()const { return first; }
+               key_iterator end()const   { return last; }
+            };
+
             typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 
             const_iterator cbegin()const {
@@ -704,6 +1244,70 @@ class multi_index
 
                return {this, &mi};
             }
+            key_iterator key_cbegin()const {
+               using namespace _multi_index_detail;
+               return key_lower_bound( secondary_key_traits<secondary_key_type>::true_lowest() );
+            }
+            key_iterator key_begin()const  { return key_cbegin(); }
+
+            key_iterator key_cend()const   { return key_iterator( this ); }
+            key_iterator key_end()const    { return key_cend(); }
+
+            /**
+             * Like lower_bound, but returns a key iterator and does not load the row it points to
+             */
+            key_iterator key_lower_bound( const secondary_key_type& secondary )const {
+               using namespace _multi_index_detail;
+
+               uint64_t primary = 0;
+               secondary_key_type secondary_copy(secondary);
+               auto itr = secondary_index_db_functions<secondary_key_type>::db_idx_lowerbound( get_code().value, get_scope(), name(), secondary_copy, primary );
+               key_iterator result( this, itr, primary );
+               if( itr >= 0 ) {
+                  result._secondary     = secondary_copy;
+                  result._has_secondary = true;
+               }
+               return result;
+            }
+
+            /**
+             * Like upper_bound, but returns a key iterator and does not load the row it points to
+             */
+            key_iterator key_upper_bound( const secondary_key_type& secondary )const {
+               using namespace _multi_index_detail;
+
+               uint64_t primary = 0;
+               secondary_key_type secondary_copy(secondary);
+               auto itr = secondary_index_db_functions<secondary_key_type>::db_idx_upperbound( get_code().value, get_scope(), name(), secondary_copy, primary );
+               key_iterator result( this, itr, primary );
+               if( itr >= 0 ) {
+                  result._secondary     = secondary_copy;
+                  result._has_secondary = true;
+               }
+               return result;
+            }
+
+            /**
+             * Gets the entries with a secondary key in [`lower`, `upper`) as key iterators.
+             * Both ends are located up front, so iterating the range never steps past `upper` and loads only the
+             * rows that are dereferenced.
+             *
+             * Example:
+             *
+             * @code
+             * auto by_age = people.get_index<"byage"_n>();
+             * auto adults = by_age.range( 18, 65 );
+             * for( auto itr = adults.begin(); itr != adults.end(); ++itr )
+             *    print( itr.primary_key(), " " );     // no row is loaded
+             * for( const auto& person : adults )
+             *    print( person.name, " " );           // each row is loaded when dereferenced
+             * @endcode
+             */
+            key_range range( const secondary_key_type& lower, const secondary_key_type& upper )const {
+               sysio::check( !(upper < lower), "upper bound of range is less than its lower bound" );
+               return { key_lower_bound( lower ), key_lower_bound( upper ) };
+            }
+
             /**
              * Warning: the interator_to can have undefined behavior if the caller 
              * passes in a reference to a stack-allocated object rather than the 
@@ -798,14 +1402,71 @@ class multi_index
          }
       };
 
+      using secondary_keys_type = decltype( make_extractor_tuple::get_extractor_tuple(indices_type{}, std::declval<const T&>()) );
+
+      // a modified row whose write to the database is deferred until flush()
+      struct dirty_row {
+         item*               _item;
+         name                _payer;
+         secondary_keys_type _stored_keys; ///< secondary keys currently in the database
+      };
+
+      bool                   _defer_writes = false;
+      std::vector<dirty_row> _dirty;
+
+      void write_row( item& objitem, name payer, const secondary_keys_type& stored_keys ) {
+         using namespace _multi_index_detail;
+
+         const T& obj = objitem;
+         uint64_t pk = _multi_index_detail::to_raw_key(obj.primary_key());
+
+         size_t size = pack_size( obj );
+         //using malloc/free here potentially is not exception-safe, although WASM doesn't support exceptions
+         void* buffer = max_stack_buffer_size < size ? malloc(size) : alloca(size);
+
+         unchecked_datastream ds( (char*)buffer, size );
+         ds << obj;
+
+         internal_use_do_not_use::db_update_i64( objitem.__primary_itr, payer.value, buffer, size );
+
+         if ( max_stack_buffer_size < size ) {
+            free( buffer );
+         }
+
+         bluegrass::meta::for_each(indices_type{}, [&](auto idx){
+            typedef std::tuple_element_t<const_index, decltype(idx)> index_type;
+            auto secondary = index_type::extract_secondary_key( obj );
+            if( memcmp( &std::get<index_type::index_number>(stored_keys), &secondary, sizeof(secondary) ) != 0 ) {
+               auto indexitr = objitem.__iters[index_type::number()];
+
+               if( indexitr < 0 ) {
+                  typename index_type::secondary_key_type temp_secondary_key;
+                  indexitr = objitem.__iters[index_type::number()]
+                           = secondary_index_db_functions<typename index_type::secondary_key_type>::db_idx_find_primary( _code.value, _scope, index_type::name(), pk,  temp_secondary_key );
+               }
+
+               secondary_index_db_functions<typename index_type::secondary_key_type>::db_idx_update( indexitr, payer.value, secondary );
+            }
+         } );
+      }
+
+      void forget_dirty( item& objitem ) {
+         if( objitem.__dirty_slot < 0 )
+            return;
+         auto slot = objitem.__dirty_slot;
+         if( size_t(slot) != _dirty.size() - 1 ) {
+            _dirty[slot] = std::move( _dirty.back() );
+            _dirty[slot]._item->__dirty_slot = slot;
+         }
+         _dirty.pop_back();
+         objitem.__dirty_slot = -1;
+      }
+
       const item& load_object_by_primary_iterator( int32_t itr )const {
          using namespace _multi_index_detail;
 
-         auto itr2 = std::find_if(_items_vector.rbegin(), _items_vector.rend(), [&](const item_ptr& ptr) {
-            return ptr._primary_itr == itr;
-         });
-         if( itr2 != _items_vector.rend() )
-            return *itr2->_item;
+         if( const item* cached = _items.find_by_primary_itr( itr ) )
+            return *cached;
 
          auto size = internal_use_do_not_use::db_get_i64( itr, nullptr, 0 );
          sysio::check( size >= 0, "error reading iterator" );
@@ -817,7 +1478,7 @@ class multi_index
 
          datastream<const char*> ds( (char*)buffer, uint32_t(size) );
 
-         auto itm = std::make_unique<item>( this, [&]( auto& i ) {
+         item* itm = _items.create( this, [&]( auto& i ) {
             T& val = static_cast<T&>(i);
             ds >> val;
 
@@ -828,17 +1489,16 @@ class multi_index
             });
          });
 
-         const item* ptr = itm.get();
          auto pk   = _multi_index_detail::to_raw_key(itm->primary_key());
          auto pitr = itm->__primary_itr;
 
-         _items_vector.emplace_back( std::move(itm), pk, pitr );
+         const item& cached = _items.insert( itm, pk, pitr );
 
          if ( max_stack_buffer_size < size_t(size) ) {
             free(buffer);
          }
 
-         return *ptr;
+         return cached;
       } /// load_object_by_primary_iterator
 
    public:
@@ -893,6 +1553,61 @@ class multi_index
       :_code(code),_scope(scope),_next_primary_key(unset_next_primary_key)
       {}
 
+      multi_index( multi_index&& ) = default;
+      multi_index& operator=( multi_index&& ) = default;
+
+      /**
+       * Writes back the rows whose writes were deferred, see defer_writes()
+       */
+      ~multi_index() {
+         flush();
+      }
+
+      /**
+       * Turns deferred writes on or off.
+       * @ingroup multiindex
+       *
+       * While deferred writes are on, `modify` only updates the cached object and marks it dirty. A dirty row is
+       * serialized and written with a single `db_update_i64`, plus a `db_idx*_update` for each secondary key that
+       * differs from the one in the database, when `flush()` is called or the table object is destroyed.
+       * Modifying the same row several times in one action then costs one write instead of one per call.
+       *
+       * Until the flush, the database still holds the old rows: secondary index lookups and iteration see the
+       * stored secondary keys, other table objects for the same table see the old values, and the last payer other
+       * than `same_payer` given for a row is charged for it. Turning deferred writes off flushes the pending rows.
+       *
+       * @param enable - Whether to defer the writes of modify
+       *
+       * Example:
+       *
+       * @code
+       *     void myaction() {
+       *       address_index addresses(_self, _self.value); // code, scope
+       *       addresses.defer_writes();
+       *       for( auto itr = addresses.begin(); itr != addresses.end(); ++itr )
+       *          addresses.modify( itr, same_payer, [&]( auto& address ) { address.visits += 1; } );
+       *       addresses.flush();
+       *     }
+       * @endcode
+       */
+      void defer_writes( bool enable = true ) {
+         if( !enable )
+            flush();
+         _defer_writes = enable;
+      }
+
+      /**
+       * Writes every row modified while deferred writes were on to the database.
+       * @ingroup multiindex
+       */
+      void flush() {
+         for( auto& d : _dirty ) {
+            d._item->__dirty_slot = -1;
+            write_row( *d._item, d._payer, d._stored_keys );
+         }
+         _dirty.clear();
+      }
+
       /**
        * Returns the `code` member property.
        * @ingroup multiindex
@@ -1574,7 +2289,7 @@ class multi_index
 
          sysio::check( _code == current_receiver(), "cannot create objects in table of another contract" ); // Quick fix for mutating db using multi_index that shouldn't allow mutation. Real fix can come in RC2.
 
-         auto itm = std::make_unique<item>( this, [&]( auto& i ){
+         item* itm = _items.create( this, [&]( auto& i ){
             T& obj = static_cast<T&>(i);
             constructor( obj );
 
@@ -1583,7 +2298,7 @@ class multi_index
             //using malloc/free here potentially is not exception-safe, although WASM doesn't support exceptions
             void* buffer = max_stack_buffer_size < size ? malloc(size) : alloca(size);
 
-            datastream<char*> ds( (char*)buffer, size );
+            unchecked_datastream ds( (char*)buffer, size );
             ds << obj;
 
             uint64_t pk = _multi_index_detail::to_raw_key(obj.primary_key());
@@ -1604,13 +2319,12 @@ class multi_index
             });
          });
 
-         const item* ptr = itm.get();
          auto pk   = _multi_index_detail::to_raw_key(itm->primary_key());
          auto pitr = itm->__primary_itr;
 
-         _items_vector.emplace_back( std::move(itm), pk, pitr );
+         const item& cached = _items.insert( itm, pk, pitr );
 
-         return {this, ptr};
+         return {this, &cached};
       }
 
       /**
@@ -1625,6 +2339,7 @@ class multi_index
        * @pre payer is a valid account that is authorized to execute the action and be billed for storage usage.
        *
        * @post The modified object is serialized, then replaces the existing object in the table.
+       * @post If deferred writes are on (see defer_writes()), only the cached object is updated and the row is written by the next flush().
        * @post Secondary indices are updated; the primary key of the updated object is not changed.
        * @post The payer is charged for the storage usage of the updated object.
        * @post If payer is the same as the existing payer, payer only pays for the usage difference between existing and updated object (and is refunded if this difference is negative).
@@ -1672,6 +2387,7 @@ class multi_index
        * @pre payer is a valid account that is authorized to execute the action and be billed for storage usage.
        *
        * @post The modified object is serialized, then replaces the existing object in the table.
+       * @post If deferred writes are on (see defer_writes()), only the cached object is updated and the row is written by the next flush().
        * @post Secondary indices are updated; the primary key of the updated object is not changed.
        * @post The payer is charged for the storage usage of the updated object.
        * @post If payer is the same as the existing payer, payer only pays for the usage difference between existing and updated object (and is refunded if this difference is negative).
@@ -1710,46 +2426,29 @@ class multi_index
          auto& mutableitem = const_cast<item&>(objitem);
          sysio::check( _code == current_receiver(), "cannot modify objects in table of another contract" ); // Quick fix for mutating db using multi_index that shouldn't allow mutation. Real fix can come in RC2.
 
-         auto secondary_keys = make_extractor_tuple::get_extractor_tuple(indices_type{}, obj);
-
          uint64_t pk = _multi_index_detail::to_raw_key(obj.primary_key());
 
+         // the secondary keys in the database are the ones from before the first deferred modification
+         const bool defer = _defer_writes;
+         if( defer && mutableitem.__dirty_slot >= 0 ) {
+            if( payer != same_payer )
+               _dirty[mutableitem.__dirty_slot]._payer = payer;
+         } else if( defer ) {
+            mutableitem.__dirty_slot = _dirty.size();
+            _dirty.push_back( { &mutableitem, payer, make_extractor_tuple::get_extractor_tuple(indices_type{}, obj) } );
+         }
+         auto secondary_keys = defer ? secondary_keys_type{} : make_extractor_tuple::get_extractor_tuple(indices_type{}, obj);
+
          auto& mutableobj = const_cast<T&>(obj); // Do not forget the auto& otherwise it would make a copy and thus not update at all.
          updater( mutableobj );
 
          sysio::check( pk == _multi_index_detail::to_raw_key(obj.primary_key()), "updater cannot change primary key when modifying an object" );
 
-         size_t size = pack_size( obj );
-         //using malloc/free here potentially is not exception-safe, although WASM doesn't support exceptions
-         void* buffer = max_stack_buffer_size < size ? malloc(size) : alloca(size);
-
-         datastream<char*> ds( (char*)buffer, size );
-         ds << obj;
-
-         internal_use_do_not_use::db_update_i64( objitem.__primary_itr, payer.value, buffer, size );
-
-         if ( max_stack_buffer_size < size ) {
-            free( buffer );
-         }
-
          if( pk >= _next_primary_key )
             _next_primary_key = (pk >= no_available_primary_key) ? no_available_primary_key : (pk + 1);
 
-         bluegrass::meta::for_each(indices_type{}, [&](auto idx){
-            typedef std::tuple_element_t<const_index, decltype(idx)> index_type;
-            auto secondary = index_type::extract_secondary_key( obj );
-            if( memcmp( &std::get<index_type::index_number>(secondary_keys), &secondary, sizeof(secondary) ) != 0 ) {
-               auto indexitr = mutableitem.__iters[index_type::number()];
-
-               if( indexitr < 0 ) {
-                  typename index_type::secondary_key_type temp_secondary_key;
-                  indexitr = mutableitem.__iters[index_type::number()]
-                           = secondary_index_db_functions<typename index_type::secondary_key_type>::db_idx_find_primary( _code.value, _scope, index_type::name(), pk,  temp_secondary_key );
-               }
-
-               secondary_index_db_functions<typename index_type::secondary_key_type>::db_idx_update( indexitr, payer.value, secondary );
-            }
-         } );
+         if( !defer )
+            write_row( mutableitem, payer, secondary_keys );
       }
 
       /**
@@ -1816,13 +2515,10 @@ class multi_index
        */
       template<typename PK>
       const_iterator find( PK primary )const {
-         auto itr2 = std::find_if(_items_vector.rbegin(), _items_vector.rend(), [&](const item_ptr& ptr) {
-            return ptr._item->primary_key() == primary;
-         });
-         if( itr2 != _items_vector.rend() )
-            return iterator_to(*(itr2->_item));
-
          uint64_t primary_int = _multi_index_detail::to_raw_key(primary);
+         if( const item* cached = _items.find_by_primary_key( primary_int ) )
+            return iterator_to(*cached);
+
          auto itr = internal_use_do_not_use::db_find_i64( _code.value, _scope, static_cast<uint64_t>(TableName), primary_int );
          if( itr < 0 ) return end();
 
@@ -1841,13 +2537,10 @@ class multi_index
 
       template<typename PK>
       const_iterator require_find( PK primary, const char* error_msg = "unable to find key" )const {
-         auto itr2 = std::find_if(_items_vector.rbegin(), _items_vector.rend(), [&](const item_ptr& ptr) {
-               return ptr._item->primary_key() == primary;
-            });
-         if( itr2 != _items_vector.rend() )
-            return iterator_to(*(itr2->_item));
-
          uint64_t primary_int = _multi_index_detail::to_raw_key(primary);
+         if( const item* cached = _items.find_by_primary_key( primary_int ) )
+            return iterator_to(*cached);
+
          auto itr = internal_use_do_not_use::db_find_i64( _code.value, _scope, static_cast<uint64_t>(TableName), primary_int );
          sysio::check( itr >= 0,  error_msg );
 
@@ -1855,6 +2548,33 @@ class multi_index
          return iterator_to(static_cast<const T&>(i));
       }
 
+      /**
+       * Search for an existing object in a table using its primary key without deserializing it.
+       * @ingroup multiindex
+       *
+       * The object is neither decoded nor added to the cache; fields are decoded one at a time when they are read
+       * from the returned view. Use this instead of `find` when only a few fields of a large row are needed.
+       *
+       * @param primary - Primary key value of the object
+       * @return A view of the found object which has a primary key equal to `primary` OR an empty view if an object with primary key `primary` is not found.
+       *
+       * Example:
+       *
+       * @code
+       * auto row = addresses.find_view("dan"_n);
+       * sysio::check(row, "Couldn't get him.");
+       * print(row.get<&address::city>());
+       * @endcode
+       */
+      template<typename PK>
+      row_view<T> find_view( PK primary )const {
+         uint64_t primary_int = _multi_index_detail::to_raw_key(primary);
+         if( const item* cached = _items.find_by_primary_key( primary_int ) )
+            return row_view<T>( static_cast<const T*>(cached) );
+
+         return row_view<T>( internal_use_do_not_use::db_find_i64( _code.value, _scope, static_cast<uint64_t>(TableName), primary_int ) );
+      }
+
       /**
        * Remove an existing object from a table using its primary key.
        * @ingroup multiindex
@@ -1941,13 +2661,10 @@ class multi_index
          sysio::check( objitem.__idx == this, "object passed to erase is not in multi_index" );
          sysio::check( _code == current_receiver(), "cannot erase objects in table of another contract" ); // Quick fix for mutating db using multi_index that shouldn't allow mutation. Real fix can come in RC2.
 
-         auto pk = objitem.primary_key();
-         auto itr2 = std::find_if(_items_vector.rbegin(), _items_vector.rend(), [&](const item_ptr& ptr) {
-            return ptr._item->primary_key() == pk;
-         });
-
-         sysio::check( itr2 != _items_vector.rend(), "attempt to remove object that was not in multi_index" );
+         uint64_t pk = _multi_index_detail::to_raw_key(objitem.primary_key());
+         sysio::check( _items.find_by_primary_key( pk ) == &objitem, "attempt to remove object that was not in multi_index" );
 
+         forget_dirty( const_cast<item&>(objitem) );
          internal_use_do_not_use::db_remove_i64( objitem.__primary_itr );
 
          bluegrass::meta::for_each(indices_type{}, [&](auto idx){
@@ -1962,7 +2679,7 @@ class multi_index
                secondary_index_db_functions<typename index_type::secondary_key_type>::db_idx_remove( i );
          });
 
-         _items_vector.erase(--(itr2.base()));
+         _items.erase( pk );
       }
 
 };
@@ -0,0 +1,198 @@
+/**
+ *  @file
+ *  @copyright defined in eos/LICENSE
+ */
+#pragma once
+
+#include "check.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace sysio {
+
+   /**
+    *  @defgroup arena Arena
+    *  @ingroup core
+    *  @brief Defines a monotonic buffer for short-lived allocations and an allocator adapter for standard containers
+    */
+
+   /**
+    *  A monotonic buffer. Allocations bump a pointer through a chain of blocks and are never freed one by one,
+    *  everything is released at once by `reset()` or when the arena is destroyed.
+    *  The first block may be a caller supplied buffer, e.g. on the stack; further blocks come from malloc and
+    *  double in size.
+    *
+    *  @ingroup arena
+    *
+    *  Example:
+    *  @code
+    *  char buffer[1024];
+    *  sysio::arena a(buffer, sizeof(buffer));
+    *  auto bytes = sysio::pack(value, a);          // no malloc while the packed value fits in buffer
+    *  sysio::arena_vector<uint64_t> ids(a);
+    *  ids.push_back(42);
+    *  a.reset();                                   // releases bytes and ids together
+    *  @endcode
+    */
+   class arena {
+      public:
+         static constexpr size_t default_block_size = 4096;
+
+         /**
+          * Construct an arena that takes its first block from malloc when first used
+          *
+          * @param block_size - Size of the first block, 0 for the default size
+          */
+         explicit arena( size_t block_size = default_block_size )
+            : _next_block_size(block_size ? block_size : default_block_size) {}
+
+         /**
+          * Construct an arena that allocates from a caller supplied buffer first
+          *
+          * @param buffer - The initial buffer, it must outlive the arena
+          * @param size - The size of the buffer
+          */
+         arena( void* buffer, size_t size )
+            : _initial((char*)buffer), _initial_size(size), _pos((char*)buffer), _end((char*)buffer + size),
+              _next_block_size(size < default_block_size ? default_block_size : size * 2) {}
+
+         arena( const arena& ) = delete;
+         arena& operator=( const arena& ) = delete;
+
+         ~arena() { release_blocks(); }
+
+         /**
+          * Allocate memory from the arena
+          *
+          * @param bytes - Number of bytes to allocate
+          * @param alignment - Alignment of the memory, a power of two
+          * @return Pointer to the allocated memory
+          */
+         void* allocate( size_t bytes, size_t alignment = alignof(std::max_align_t) ) {
+            char* p = align( _pos, alignment );
+            if ( !_pos || p > _end || bytes > size_t(_end - p) ) {
+               add_block( bytes + alignment );
+               p = align( _pos, alignment );
+            }
+            _pos = p + bytes;
+            _used += bytes;
+            return p;
+         }
+
+         /**
+          * Memory is reclaimed by `reset()`, individual deallocations are no-ops
+          */
+         void deallocate( void*, size_t, size_t = alignof(std::max_align_t) ) {}
+
+         /**
+          * Release all allocations. Blocks taken from malloc are freed and the arena starts over from its initial buffer
+          */
+         void reset() {
+            release_blocks();
+            _pos  = _initial;
+            _end  = _initial + _initial_size;
+            _used = 0;
+         }
+
+         /**
+          * Get the number of bytes handed out since construction or the last reset
+          *
+          * @return size_t - Number of bytes allocated
+          */
+         size_t used() const { return _used; }
+
+      private:
+         struct block_header {
+            block_header* prev;
+         };
+
+         static char* align( char* p, size_t alignment ) {
+            return (char*)(((uintptr_t)p + alignment - 1) & ~(uintptr_t)(alignment - 1));
+         }
+
+         void add_block( size_t min_size ) {
+            size_t size = _next_block_size;
+            while ( size < min_size + sizeof(block_header) )
+               size *= 2;
+            auto* block = (block_header*)malloc( size );
+            sysio::check( block != nullptr, "arena failed to allocate a block" );
+            block->prev = _blocks;
+            _blocks = block;
+            _pos = (char*)(block + 1);
+            _end = (char*)block + size;
+            _next_block_size = size * 2;
+         }
+
+         void release_blocks() {
+            while ( _blocks ) {
+               block_header* prev = _blocks->prev;
+               free( _blocks );
+               _blocks = prev;
+            }
+         }
+
+         char*         _initial      = nullptr;
+         size_t        _initial_size = 0;
+         char*         _pos          = nullptr;
+         char*         _end          = nullptr;
+         block_header* _blocks       = nullptr;
+         size_t        _next_block_size;
+         size_t        _used         = 0;
+   };
+
+   /**
+    *  Allocator adapter that lets standard containers allocate from an @ref arena
+    *
+    *  @ingroup arena
+    *  @tparam T - Type of the allocated objects
+    */
+   template<typename T>
+   class arena_allocator {
+      public:
+         using value_type = T;
+
+         arena_allocator( arena& a ) : _arena(&a) {}
+
+         template<typename U>
+         arena_allocator( const arena_allocator<U>& other ) : _arena(other.get_arena()) {}
+
+         T* allocate( size_t n ) {
+            return static_cast<T*>( _arena->allocate( n * sizeof(T), alignof(T) ) );
+         }
+
+         void deallocate( T* p, size_t n ) {
+            _arena->deallocate( p, n * sizeof(T), alignof(T) );
+         }
+
+         arena* get_arena() const { return _arena; }
+
+         friend bool operator == ( const arena_allocator& a, const arena_allocator& b ) {
+            return a._arena == b._arena;
+         }
+
+         friend bool operator != ( const arena_allocator& a, const arena_allocator& b ) {
+            return a._arena != b._arena;
+         }
+
+      private:
+         arena* _arena;
+   };
+
+   /**
+    *  A vector whose storage lives in an @ref arena
+    *
+    *  @ingroup arena
+    */
+   template<typename T>
+   using arena_vector = std::vector<T, arena_allocator<T>>;
+
+   /**
+    *  Byte buffer whose storage lives in an @ref arena, as returned by `pack(value, arena)`
+    *
+    *  @ingroup arena
+    */
+   using arena_bytes = arena_vector<char>;
+}
@@ -425,8 +425,7 @@ namespace sysio {
        * %Print the extended asset
        */
       void print()const {
-         quantity.print();
-         ::sysio::print("@", contract);
+         ::sysio::print( quantity, "@", contract );
       }
 
       /// @cond OPERATORS
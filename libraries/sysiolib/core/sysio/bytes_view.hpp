@@ -0,0 +1,129 @@
+/**
+ *  @file
+ *  @copyright defined in eos/LICENSE
+ */
+#pragma once
+
+#include "datastream.hpp"
+
+#include <string.h>
+#include <string_view>
+#include <vector>
+
+namespace sysio {
+   /**
+    * @defgroup bytes_view Bytes View
+    * @ingroup core
+    * @ingroup types
+    * @brief Read-only view of a sequence of bytes which is deserialized without copying
+    */
+
+   /**
+    *  A read-only view of a sequence of bytes which does not own its storage. It is serialized as `bytes`.
+    *
+    *  Deserializing a bytes_view points it into the buffer of the datastream, so it is only valid as long as that
+    *  buffer is. Action arguments stay valid for the whole action, so large blobs can be received without a copy.
+    *
+    *  @ingroup bytes_view
+    */
+   class bytes_view {
+      public:
+         /**
+          * Construct an empty bytes_view
+          */
+         constexpr bytes_view() = default;
+
+         /**
+          * Construct a bytes_view of `size` bytes starting at `data`
+          *
+          * @param data - Pointer to the first byte
+          * @param size - Number of bytes
+          */
+         constexpr bytes_view( const char* data, size_t size ) : _data(data), _size(size) {}
+
+         /**
+          * Construct a bytes_view of the contents of a vector
+          *
+          * @param v - The vector, which has to outlive the view
+          */
+         template<typename Alloc>
+         bytes_view( const std::vector<char, Alloc>& v ) : _data(v.data()), _size(v.size()) {}
+
+         constexpr const char* data()const { return _data; }
+         constexpr size_t size()const { return _size; }
+         constexpr bool empty()const { return _size == 0; }
+         constexpr const char* begin()const { return _data; }
+         constexpr const char* end()const { return _data + _size; }
+         constexpr char operator[]( size_t i )const { return _data[i]; }
+
+         /**
+          * Get a view of `count` bytes starting at `offset`
+          *
+          * @param offset - Index of the first byte
+          * @param count - Number of bytes
+          * @return bytes_view - The view
+          */
+         bytes_view subview( size_t offset, size_t count )const {
+            sysio::check( offset <= _size && count <= _size - offset, "bytes_view subview out of range" );
+            return bytes_view( _data + offset, count );
+         }
+
+         /**
+          * Copy the bytes into a vector
+          *
+          * @return std::vector<char> - The copy
+          */
+         std::vector<char> to_vector()const { return std::vector<char>( begin(), end() ); }
+
+         /**
+          * Get the bytes as a string_view
+          *
+          * @return std::string_view - A view of the same bytes
+          */
+         constexpr std::string_view to_string_view()const { return std::string_view( _data, _size ); }
+
+         friend bool operator==( const bytes_view& a, const bytes_view& b ) {
+            return a._size == b._size && (a._size == 0 || memcmp( a._data, b._data, a._size ) == 0);
+         }
+
+         friend bool operator!=( const bytes_view& a, const bytes_view& b ) {
+            return !(a == b);
+         }
+
+      private:
+         const char* _data = nullptr;
+         size_t      _size = 0;
+   };
+
+   /**
+    *  Serialize a bytes_view into a stream, in the same format as a vector of bytes
+    *
+    *  @param ds - The stream to write
+    *  @param v - The value to serialize
+    *  @tparam Stream - Type of datastream buffer
+    *  @return datastream<Stream>& - Reference to the datastream
+    */
+   template<typename Stream>
+   datastream<Stream>& operator << ( datastream<Stream>& ds, const bytes_view& v ) {
+      ds << unsigned_int( v.size() );
+      if (v.size())
+         ds.write( v.data(), v.size() );
+      return ds;
+   }
+
+   /**
+    *  Deserialize bytes without copying them. The bytes_view points into the buffer of the stream.
+    *
+    *  @param ds - The stream to read
+    *  @param v - The destination for deserialized value
+    *  @tparam Stream - Type of datastream buffer
+    *  @return datastream<Stream>& - Reference to the datastream
+    */
+   template<typename Stream>
+   datastream<Stream>& operator >> ( datastream<Stream>& ds, bytes_view& v ) {
+      size_t size = 0;
+      const char* data = _datastream_detail::borrow_bytes( ds, size );
+      v = bytes_view( data, size );
+      return ds;
+   }
+}
@@ -3,6 +3,7 @@
  *  @copyright defined in eos/LICENSE
  */
 #pragma once
+#include "arena.hpp"
 #include "check.hpp"
 #include "varint.hpp"
 #include <bluegrass/meta/for_each.hpp>
@@ -16,6 +17,10 @@
 #include <string>
 #include <optional>
 #include <variant>
+#include <string_view>
+#if __has_include(<span>)
+#include <span>
+#endif
 
 #include <string.h>
 
@@ -273,6 +278,144 @@ class datastream<size_t> {
      size_t _size;
 };
 
+/**
+ * Buffer type of a datastream which writes without bounds checks
+ */
+struct unchecked_buffer {};
+
+/**
+ *  Specialization of datastream which writes into a buffer already known to be large enough, such as one of the
+ *  size computed by pack_size() for the value written. It skips the bounds check of every write, which is a
+ *  branch per field on the hot path of pack(), so it must never be given a buffer of unverified size.
+ */
+template<>
+class datastream<unchecked_buffer> {
+   public:
+      /**
+       * Construct a new unchecked datastream object
+       *
+       * @param start - The start position of the buffer
+       * @param s - The size of the buffer, which the caller guarantees holds everything written
+       */
+      datastream( char* start, size_t s )
+      :_start(start),_pos(start),_end(start+s){}
+
+     /**
+      *  Skips a specified number of bytes from this stream
+      *
+      *  @param s - The number of bytes to skip
+      */
+      inline void skip( size_t s ){ _pos += s; }
+
+     /**
+      *  Writes a specified number of bytes into the stream from a buffer
+      *
+      *  @param d - The pointer to the source buffer
+      *  @param s - The number of bytes to write
+      *  @return true
+      */
+      inline bool write( const char* d, size_t s ) {
+        memcpy( _pos, d, s );
+        _pos += s;
+        return true;
+      }
+
+     /**
+      *  Writes a specified byte into the stream
+      *
+      *  @param d - The byte to be written
+      *  @return true
+      */
+      inline bool write( char d ) {
+        *_pos++ = d;
+        return true;
+      }
+
+     /**
+      *  Writes a specified number of bytes into the stream from a buffer
+      *
+      *  @param d - The pointer to the source buffer
+      *  @param s - The number of bytes to write
+      *  @return true
+      */
+      inline bool write( const void* d, size_t s ) {
+        memcpy( _pos, d, s );
+        _pos += s;
+        return true;
+      }
+
+     /**
+      *  Writes a byte into the stream
+      *
+      *  @param c byte to write
+      *  @return true
+      */
+      inline bool put(char c) {
+        *_pos++ = c;
+        return true;
+      }
+
+     /**
+      *  Retrieves the current position of the stream
+      *
+      *  @return char* - The current position of the stream
+      */
+      char* pos()const { return _pos; }
+      inline bool valid()const { return _pos <= _end && _pos >= _start;  }
+
+     /**
+      *  Sets the position within the current stream
+      *
+      *  @param p - The offset relative to the origin
+      *  @return true if p is within the range
+      *  @return false if p is not within the range
+      */
+      inline bool seekp(size_t p) { _pos = _start + p; return _pos <= _end; }
+
+     /**
+      *  Gets the position within the current stream
+      *
+      *  @return p - The position within the current stream
+      */
+      inline size_t tellp()const      { return size_t(_pos - _start); }
+
+     /**
+      *  Returns the number of remaining bytes that can be written
+      *
+      *  @return size_t - The number of remaining bytes
+      */
+      inline size_t remaining()const  { return _end - _pos; }
+    private:
+      char* _start;
+      char* _pos;
+      char* _end;
+};
+
+/**
+ * A datastream which writes without bounds checks
+ *
+ * @ingroup datastream
+ */
+using unchecked_datastream = datastream<unchecked_buffer>;
+
+namespace _datastream_detail {
+   template<typename T>
+   constexpr size_t min_pack_size();
+
+   /**
+    * Checks that the stream holds enough bytes for `count` elements of at least `min_size` bytes each, so that a
+    * malformed size prefix fails before anything is allocated for it
+    *
+    * @param ds - The stream to read
+    * @param count - The number of elements read from the size prefix
+    * @param min_size - The fewest bytes an element packs to, or 0 if an element may pack to nothing
+    */
+   template<typename Stream>
+   void check_count( const datastream<Stream>& ds, uint32_t count, size_t min_size ) {
+      sysio::check( min_size == 0 || count <= ds.remaining() / min_size, "datastream attempted to read past the end" );
+   }
+}
+
 /**
  *  Serialize an std::list into a stream
  *
@@ -301,9 +444,12 @@ template<typename Stream, typename T>
 inline datastream<Stream>& operator>>(datastream<Stream>& ds, std::list<T>& l) {
    unsigned_int s;
    ds >> s;
-   l.resize(s.value);
-   for( auto& i : l )
-      ds >> i;
+   _datastream_detail::check_count( ds, s.value, _datastream_detail::min_pack_size<T>() );
+   l.clear();
+   for( uint32_t i = 0; i < s.value; ++i ) {
+      l.emplace_back();
+      ds >> l.back();
+   }
    return ds;
 }
 
@@ -335,9 +481,12 @@ template<typename Stream, typename T>
 inline datastream<Stream>& operator>>(datastream<Stream>& ds, std::deque<T>& d) {
    unsigned_int s;
    ds >> s;
-   d.resize(s.value);
-   for( auto& i : d )
-      ds >> i;
+   _datastream_detail::check_count( ds, s.value, _datastream_detail::min_pack_size<T>() );
+   d.clear();
+   for( uint32_t i = 0; i < s.value; ++i ) {
+      d.emplace_back();
+      ds >> d.back();
+   }
    return ds;
 }
 
@@ -516,14 +665,105 @@ datastream<Stream>& operator << ( datastream<Stream>& ds, const std::string& v )
  */
 template<typename Stream>
 datastream<Stream>& operator >> ( datastream<Stream>& ds, std::string& v ) {
-   std::vector<char> tmp;
-   ds >> tmp;
-   if( tmp.size() )
-      v = std::string(tmp.data(),tmp.data()+tmp.size());
-   else
-      v = std::string();
+   unsigned_int s;
+   ds >> s;
+   _datastream_detail::check_count( ds, s.value, 1 );
+   v.resize( s.value );
+   if( s.value )
+      ds.read( v.data(), s.value );
+   return ds;
+}
+
+namespace _datastream_detail {
+   /**
+    * Reads a size prefix and returns a pointer to that many bytes inside the buffer of the stream, which is
+    * skipped past them
+    *
+    * @param ds - The stream to read
+    * @param size - Set to the number of bytes
+    * @return const char* - Pointer to the first byte in the buffer of the stream
+    */
+   template<typename Stream>
+   const char* borrow_bytes( datastream<Stream>& ds, size_t& size ) {
+      unsigned_int s;
+      ds >> s;
+      sysio::check( ds.remaining() >= s.value, "datastream attempted to read past the end" );
+      const char* data = ds.pos();
+      ds.skip( s.value );
+      size = s.value;
+      return data;
+   }
+}
+
+/**
+ *  Serialize a string_view into a stream, in the same format as a string
+ *
+ *  @param ds - The stream to write
+ *  @param v - The value to serialize
+ *  @tparam Stream - Type of datastream buffer
+ *  @return datastream<Stream>& - Reference to the datastream
+ */
+template<typename Stream>
+datastream<Stream>& operator << ( datastream<Stream>& ds, const std::string_view& v ) {
+   ds << unsigned_int( v.size() );
+   if (v.size())
+      ds.write(v.data(), v.size());
+   return ds;
+}
+
+/**
+ *  Deserialize a string without copying it. The string_view points into the buffer of the stream and is only
+ *  valid as long as that buffer is.
+ *
+ *  @param ds - The stream to read
+ *  @param v - The destination for deserialized value
+ *  @tparam Stream - Type of datastream buffer
+ *  @return datastream<Stream>& - Reference to the datastream
+ */
+template<typename Stream>
+datastream<Stream>& operator >> ( datastream<Stream>& ds, std::string_view& v ) {
+   size_t size = 0;
+   const char* data = _datastream_detail::borrow_bytes( ds, size );
+   v = std::string_view( data, size );
+   return ds;
+}
+
+#ifdef __cpp_lib_span
+/**
+ *  Serialize a span of bytes into a stream, in the same format as a vector of bytes
+ *
+ *  @param ds - The stream to write
+ *  @param v - The value to serialize
+ *  @tparam Stream - Type of datastream buffer
+ *  @tparam T - Type of the bytes in the span
+ *  @return datastream<Stream>& - Reference to the datastream
+ */
+template<typename Stream, typename T, std::size_t Extent, std::enable_if_t<sizeof(T) == 1>* = nullptr>
+datastream<Stream>& operator << ( datastream<Stream>& ds, const std::span<T, Extent>& v ) {
+   ds << unsigned_int( v.size() );
+   if (v.size())
+      ds.write( (const void*)v.data(), v.size() );
+   return ds;
+}
+
+/**
+ *  Deserialize a vector of bytes without copying it. The span points into the buffer of the stream and is only
+ *  valid as long as that buffer is.
+ *
+ *  @param ds - The stream to read
+ *  @param v - The destination for deserialized value
+ *  @tparam Stream - Type of datastream buffer
+ *  @tparam T - Type of the bytes in the span
+ *  @return datastream<Stream>& - Reference to the datastream
+ */
+template<typename Stream, typename T, std::enable_if_t<sizeof(T) == 1>* = nullptr>
+datastream<Stream>& operator >> ( datastream<Stream>& ds, std::span<const T>& v ) {
+   size_t size = 0;
+   const char* data = _datastream_detail::borrow_bytes( ds, size );
+   v = std::span<const T>( (const T*)data, size );
    return ds;
 }
+#endif
 
 /**
  *  Serialize a fixed size std::array
@@ -599,6 +839,145 @@ namespace _datastream_detail {
    struct is_datastream<datastream<T>> { static constexpr bool value = true; };
 }
 
+template<typename T>
+struct fixed_pack_size;
+
+namespace _datastream_detail {
+   template<typename T>
+   struct is_std_array : std::false_type {};
+   template<typename T, std::size_t N>
+   struct is_std_array<std::array<T,N>> : std::true_type {};
+
+   /*
+    * Check if type T defines its own serialization with SYSLIB_SERIALIZE, rather than inheriting it from a base,
+    * and its members can be visited
+    *
+    * @tparam T - The type to be checked
+    */
+   template<typename T, typename = void>
+   struct has_syslib_members : std::false_type {};
+   template<typename T>
+   struct has_syslib_members<T, std::enable_if_t<std::is_same<typename T::_syslib_serialized_type, T>::value,
+                                                 std::void_t<decltype(T::_syslib_for_each_member(std::declval<void(*)(int)>()))>>>
+      : std::true_type {};
+
+   template<typename M>
+   struct member_type {};
+   template<typename C, typename M>
+   struct member_type<M C::*> { using type = std::remove_cv_t<M>; };
+
+   template<typename T>
+   constexpr size_t syslib_members_pack_size() {
+      size_t size  = 0;
+      bool   fixed = true;
+      T::_syslib_for_each_member([&](auto member) {
+         constexpr size_t member_size = fixed_pack_size<typename member_type<decltype(member)>::type>::value;
+         size += member_size;
+         fixed = fixed && member_size > 0;
+      });
+      return fixed ? size : 0;
+   }
+
+   template<typename T>
+   constexpr size_t compute_fixed_pack_size() {
+      if constexpr ( is_primitive<T>() ) {
+         return sizeof(T);
+      } else if constexpr ( is_std_array<T>::value ) {
+         return std::tuple_size<T>::value * fixed_pack_size<std::remove_cv_t<typename T::value_type>>::value;
+      } else if constexpr ( has_syslib_members<T>::value ) {
+         return syslib_members_pack_size<T>();
+      } else {
+         return 0;
+      }
+   }
+}
+
+/**
+ *  The number of bytes T always packs to, or 0 if the packed size of T depends on its value
+ *
+ *  Primitive types, `std::array` of fixed size types and classes whose SYSLIB_SERIALIZE members are all of fixed size
+ *  are detected. Types with a custom serialization of constant size can specialize this template.
+ *
+ *  @ingroup datastream
+ *  @tparam T - The type to be checked
+ */
+template<typename T>
+struct fixed_pack_size : std::integral_constant<size_t, _datastream_detail::compute_fixed_pack_size<T>()> {};
+
+/**
+ *  The number of bytes T always packs to, or 0 if the packed size of T depends on its value
+ *
+ *  @ingroup datastream
+ *  @tparam T - The type to be checked
+ */
+template<typename T>
+inline constexpr size_t fixed_pack_size_v = fixed_pack_size<std::remove_cv_t<T>>::value;
+
+namespace _datastream_detail {
+   template<typename T>
+   struct is_size_prefixed : std::false_type {};
+   template<typename T, typename Alloc>
+   struct is_size_prefixed<std::vector<T, Alloc>> : std::true_type {};
+   template<typename T>
+   struct is_size_prefixed<std::basic_string<T>> : std::true_type {};
+   template<typename T>
+   struct is_size_prefixed<std::list<T>> : std::true_type {};
+   template<typename T>
+   struct is_size_prefixed<std::deque<T>> : std::true_type {};
+   template<typename T>
+   struct is_size_prefixed<std::set<T>> : std::true_type {};
+   template<typename K, typename V>
+   struct is_size_prefixed<std::map<K, V>> : std::true_type {};
+   template<typename T>
+   struct is_size_prefixed<std::optional<T>> : std::true_type {};
+   template<typename... Ts>
+   struct is_size_prefixed<std::variant<Ts...>> : std::true_type {};
+
+   template<typename T>
+   struct is_tuple : std::false_type {};
+   template<typename... Ts>
+   struct is_tuple<std::tuple<Ts...>> : std::true_type {};
+   template<typename T1, typename T2>
+   struct is_tuple<std::pair<T1, T2>> : std::true_type {};
+
+   template<typename T>
+   constexpr size_t syslib_members_min_pack_size() {
+      size_t size = 0;
+      T::_syslib_for_each_member([&](auto member) {
+         size += min_pack_size<typename member_type<decltype(member)>::type>();
+      });
+      return size;
+   }
+
+   template<typename T, std::size_t... Is>
+   constexpr size_t tuple_min_pack_size( std::index_sequence<Is...> ) {
+      return (size_t(0) + ... + min_pack_size<std::remove_cv_t<std::tuple_element_t<Is, T>>>());
+   }
+
+   /**
+    * The fewest bytes a value of type T packs to, used to bound the element count read from a size prefix.
+    * Types which are not recognized count as 0 bytes, which never rejects valid data.
+    *
+    * @tparam T - The type to be checked
+    */
+   template<typename T>
+   constexpr size_t min_pack_size() {
+      if constexpr ( fixed_pack_size_v<T> > 0 ) {
+         return fixed_pack_size_v<T>;
+      } else if constexpr ( is_size_prefixed<T>::value ) {
+         return 1; // the size prefix, or the tag of an optional or a variant
+      } else if constexpr ( is_std_array<T>::value ) {
+         return std::tuple_size<T>::value * min_pack_size<std::remove_cv_t<typename T::value_type>>();
+      } else if constexpr ( is_tuple<T>::value ) {
+         return tuple_min_pack_size<T>( std::make_index_sequence<std::tuple_size<T>::value>{} );
+      } else if constexpr ( has_syslib_members<T>::value ) {
+         return syslib_members_min_pack_size<T>();
+      } else {
+         return 0;
+      }
+   }
+}
+
 /**
  *  Deserialize a pointer
  *
@@ -701,9 +1080,9 @@ datastream<Stream>& operator >> ( datastream<Stream>& ds, T (&v)[N] ) {
  *  @tparam Stream - Type of datastream buffer
  *  @return datastream<Stream>& - Reference to the datastream
  */
-template<typename Stream, typename T, 
+template<typename Stream, typename T, typename Alloc,
 	std::enable_if_t<_datastream_detail::is_primitive<T>()>* = nullptr>
-datastream<Stream>& operator << ( datastream<Stream>& ds, const std::vector<T>& v ) {
+datastream<Stream>& operator << ( datastream<Stream>& ds, const std::vector<T, Alloc>& v ) {
    ds << unsigned_int( v.size() );
    ds.write( (const void*)v.data(), v.size()*sizeof(T) );
    return ds;
@@ -718,12 +1097,16 @@ datastream<Stream>& operator << ( datastream<Stream>& ds, const std::vector<T>&
  *  @tparam T - Type of the object contained in the vector
  *  @return datastream<Stream>& - Reference to the datastream
  */
-template<typename Stream, typename T,
+template<typename Stream, typename T, typename Alloc,
 	std::enable_if_t<!_datastream_detail::is_primitive<T>()>* = nullptr>
-datastream<Stream>& operator << ( datastream<Stream>& ds, const std::vector<T>& v ) {
+datastream<Stream>& operator << ( datastream<Stream>& ds, const std::vector<T, Alloc>& v ) {
    ds << unsigned_int( v.size() );
-   for( const auto& i : v )
-      ds << i;
+   if constexpr ( std::is_same<Stream, size_t>::value && fixed_pack_size_v<T> > 0 ) {
+      ds.skip( v.size() * fixed_pack_size_v<T> );
+   } else {
+      for( const auto& i : v )
+         ds << i;
+   }
    return ds;
 }
 
@@ -735,11 +1118,12 @@ datastream<Stream>& operator << ( datastream<Stream>& ds, const std::vector<T>&
  *  @tparam Stream - Type of datastream buffer
  *  @return datastream<Stream>& - Reference to the datastream
  */
-template<typename Stream, typename T,
+template<typename Stream, typename T, typename Alloc,
 	std::enable_if_t<_datastream_detail::is_primitive<T>()>* = nullptr>
-datastream<Stream>& operator >> ( datastream<Stream>& ds, std::vector<T>& v ) {
+datastream<Stream>& operator >> ( datastream<Stream>& ds, std::vector<T, Alloc>& v ) {
    unsigned_int s;
    ds >> s;
+   _datastream_detail::check_count( ds, s.value, sizeof(T) );
    v.resize( s.value );
    ds.read( (char*)v.data(), v.size()*sizeof(T) );
    return ds;
@@ -754,14 +1138,24 @@ datastream<Stream>& operator >> ( datastream<Stream>& ds, std::vector<T>& v ) {
  *  @tparam T - Type of the object contained in the vector
  *  @return datastream<Stream>& - Reference to the datastream
  */
-template<typename Stream, typename T,
+template<typename Stream, typename T, typename Alloc,
 	std::enable_if_t<!_datastream_detail::is_primitive<T>()>* = nullptr>
-datastream<Stream>& operator >> ( datastream<Stream>& ds, std::vector<T>& v ) {
+datastream<Stream>& operator >> ( datastream<Stream>& ds, std::vector<T, Alloc>& v ) {
    unsigned_int s;
    ds >> s;
-   v.resize(s.value);
-   for( auto& i : v )
-      ds >> i;
+   if constexpr ( _datastream_detail::min_pack_size<T>() > 0 ) {
+      _datastream_detail::check_count( ds, s.value, _datastream_detail::min_pack_size<T>() );
+      v.resize(s.value);
+      for( auto& i : v )
+         ds >> i;
+   } else {
+      // the count cannot be bounded by the bytes left, so the vector only grows with the elements actually read
+      v.clear();
+      for( uint32_t i = 0; i < s.value; ++i ) {
+         v.emplace_back();
+         ds >> v.back();
+      }
+   }
    return ds;
 }
 
@@ -795,6 +1189,7 @@ template<typename Stream, typename T>
 datastream<Stream>& operator >> ( datastream<Stream>& ds, std::basic_string<T>& s ) {
    unsigned_int v;
    ds >> v;
+   _datastream_detail::check_count( ds, v.value, sizeof(T) );
    s.resize(v.value);
    ds.read(s.data(), s.size()*sizeof(T));
    return ds;
@@ -830,6 +1225,7 @@ template<typename Stream>
 datastream<Stream>& operator >> ( datastream<Stream>& ds, std::basic_string<uint8_t>& s ) {
    unsigned_int v;
    ds >> v;
+   _datastream_detail::check_count( ds, v.value, 1 );
    s.resize(v.value);
    ds.read(s.data(), s.size());
    return ds;
@@ -868,11 +1264,13 @@ template<typename Stream, typename T>
 datastream<Stream>& operator >> ( datastream<Stream>& ds, std::set<T>& s ) {
    s.clear();
    unsigned_int sz; ds >> sz;
+   _datastream_detail::check_count( ds, sz.value, _datastream_detail::min_pack_size<T>() );
 
+   // packed sets are sorted, so every element goes at the end
    for( uint32_t i = 0; i < sz.value; ++i ) {
       T v;
       ds >> v;
-      s.emplace( std::move(v) );
+      s.emplace_hint( s.end(), std::move(v) );
    }
    return ds;
 }
@@ -910,11 +1308,14 @@ template<typename Stream, typename K, typename V>
 datastream<Stream>& operator >> ( datastream<Stream>& ds, std::map<K,V>& m ) {
    m.clear();
    unsigned_int s; ds >> s;
+   _datastream_detail::check_count( ds, s.value,
+                                    _datastream_detail::min_pack_size<K>() + _datastream_detail::min_pack_size<V>() );
 
+   // packed maps are sorted by key, so every element goes at the end
    for (uint32_t i = 0; i < s.value; ++i) {
       K k; V v;
       ds >> k >> v;
-      m.emplace( std::move(k), std::move(v) );
+      m.emplace_hint( m.end(), std::move(k), std::move(v) );
    }
    return ds;
 }
@@ -1058,8 +1459,8 @@ void unpack( T& res, const char* buffer, size_t len ) {
  * @param bytes - Buffer
  * @return T - The unpacked data
  */
-template<typename T>
-T unpack( const std::vector<char>& bytes ) {
+template<typename T, typename Alloc>
+T unpack( const std::vector<char, Alloc>& bytes ) {
    return unpack<T>( bytes.data(), bytes.size() );
 }
 
@@ -1073,9 +1474,13 @@ T unpack( const std::vector<char>& bytes ) {
  */
 template<typename T>
 size_t pack_size( const T& value ) {
-  datastream<size_t> ps;
-  ps << value;
-  return ps.tellp();
+  if constexpr ( fixed_pack_size_v<T> > 0 ) {
+     return fixed_pack_size_v<T>;
+  } else {
+     datastream<size_t> ps;
+     ps << value;
+     return ps.tellp();
+  }
 }
 
 /**
@@ -1091,7 +1496,25 @@ std::vector<char> pack( const T& value ) {
   std::vector<char> result;
   result.resize(pack_size(value));
 
-  datastream<char*> ds( result.data(), result.size() );
+  unchecked_datastream ds( result.data(), result.size() );
+  ds << value;
+  return result;
+}
+
+/**
+ * Get packed data in a buffer allocated from an arena
+ *
+ * @ingroup datastream
+ * @tparam T - Type of the data to be packed
+ * @param value - Data to be packed
+ * @param a - The arena that owns the returned buffer
+ * @return arena_bytes - The packed data
+ */
+template<typename T>
+arena_bytes pack( const T& value, arena& a ) {
+  arena_bytes result( pack_size(value), a );
+
+  unchecked_datastream ds( result.data(), result.size() );
   ds << value;
   return result;
 }
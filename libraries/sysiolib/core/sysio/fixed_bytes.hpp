@@ -386,5 +386,8 @@ namespace sysio {
       return ds;
    }
 
+   template<size_t Size>
+   struct fixed_pack_size<fixed_bytes<Size>> : std::integral_constant<size_t, Size> {};
+
    /// @endcond
 }
@@ -0,0 +1,42 @@
+/**
+ *  @file
+ *  @copyright defined in eos/LICENSE
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sysio {
+
+   /**
+    *  Usage counters of the contract heap.
+    *
+    *  @ingroup system
+    */
+   struct heap_stats {
+      /// Bytes between the start of the heap and its current top
+      size_t   heap_bytes;
+      /// Bytes held by live allocations, including chunk headers
+      size_t   allocated_bytes;
+      /// Largest value `allocated_bytes` has reached
+      size_t   peak_allocated_bytes;
+      /// Bytes sitting in free lists, ready to be reused
+      size_t   free_bytes;
+      /// WASM pages requested from the host by the allocator
+      uint32_t pages_grown;
+      uint32_t malloc_count;
+      uint32_t free_count;
+      /// Calls to realloc that were satisfied without moving the allocation
+      uint32_t realloc_in_place_count;
+   };
+
+   /**
+    *  Returns the usage counters of the heap.
+    *  Only the size-class allocator keeps these counters, so this is available only when linking with `-use-size-class-malloc`.
+    *
+    *  @ingroup system
+    */
+   heap_stats get_heap_stats();
+
+} // ns sysio
@@ -200,9 +200,10 @@ void to_key_varuint32(std::uint32_t obj, datastream<S>& stream) {
       num_bytes = 5;
    }
 
-   stream.write(
-         static_cast<char>(~(0xFFu >> (num_bytes - 1)) | (num_bytes == 5 ? 0 : (obj >> ((num_bytes - 1) * 8)))));
-   for (int i = num_bytes - 2; i >= 0; --i) { stream.write(static_cast<char>((obj >> i * 8) & 0xFFu)); }
+   char buffer[5];
+   buffer[0] = static_cast<char>(~(0xFFu >> (num_bytes - 1)) | (num_bytes == 5 ? 0 : (obj >> ((num_bytes - 1) * 8))));
+   for (int i = num_bytes - 2; i >= 0; --i) { buffer[num_bytes - 1 - i] = static_cast<char>((obj >> i * 8) & 0xFFu); }
+   stream.write(buffer, num_bytes);
 }
 
 // for non-negative values
@@ -5,8 +5,10 @@
 #pragma once
 #include <utility>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
-
+#include <string.h>
 
 namespace sysio {
    namespace internal_use_do_not_use {
@@ -172,6 +174,165 @@ namespace sysio {
          t.print();
    }
 
+   char* write_decimal( char* begin, char* end, bool dry_run, uint64_t number, uint8_t num_decimal_places, bool negative );
+
+   /**
+    *  Collects formatted output in a buffer on the stack and prints it with a single `prints_l` when it is destroyed,
+    *  so that a message made of many values costs one host call. Output which does not fit is printed in chunks.
+    *
+    *  @ingroup console
+    */
+   class print_buffer {
+      public:
+         static constexpr size_t capacity = 256;
+
+         print_buffer() = default;
+         print_buffer( const print_buffer& ) = delete;
+         print_buffer& operator=( const print_buffer& ) = delete;
+         ~print_buffer() { flush(); }
+
+         /**
+          *  Prints the buffered output
+          */
+         void flush() {
+            if( _size )
+               internal_use_do_not_use::prints_l( _buffer, _size );
+            _size = 0;
+         }
+
+         /**
+          *  Appends `len` characters, which are printed directly when they are larger than the buffer
+          *
+          *  @param str - The characters to append
+          *  @param len - The number of characters
+          */
+         void append( const char* str, size_t len ) {
+            if( len > capacity - _size ) {
+               flush();
+               if( len > capacity ) {
+                  internal_use_do_not_use::prints_l( str, len );
+                  return;
+               }
+            }
+            memcpy( _buffer + _size, str, len );
+            _size += len;
+         }
+
+         /**
+          *  Makes room for `len` characters, which must not be more than the capacity, and returns where they go
+          *
+          *  @param len - The number of characters to be written
+          *  @return char* - Where to write them, to be followed by commit()
+          */
+         char* reserve( size_t len ) {
+            if( len > capacity - _size )
+               flush();
+            return _buffer + _size;
+         }
+
+         /**
+          *  Adds `len` characters written at the position returned by reserve() to the output
+          */
+         void commit( size_t len ) { _size += len; }
+
+      private:
+         char   _buffer[capacity];
+         size_t _size = 0;
+   };
+
+   namespace _print_detail {
+      template<typename T, typename = void>
+      struct has_write_as_string : std::false_type {};
+      template<typename T>
+      struct has_write_as_string<T, std::void_t<decltype(std::declval<const T&>().write_as_string(
+                                                   std::declval<char*>(), std::declval<char*>(), true ))>>
+         : std::true_type {};
+
+      template<typename T, typename = void>
+      struct has_byte_array : std::false_type {};
+      template<typename T>
+      struct has_byte_array<T, std::void_t<decltype(std::declval<const T&>().extract_as_byte_array())>>
+         : std::true_type {};
+   }
+
+   /**
+    *  Formats a value into a print_buffer, as print() would print it. Strings, booleans and integers up to 64 bits,
+    *  types which can write themselves as a string, such as name, symbol and asset, and fixed_bytes are formatted in
+    *  the buffer. Floating point and 128 bit numbers and other types are printed by their own print() after the
+    *  buffered output.
+    *
+    *  @ingroup console
+    *  @param out - The buffer
+    *  @param v - The value to format
+    */
+   template<typename T>
+   void print_to( print_buffer& out, const T& v ) {
+      using U = std::decay_t<T>;
+      if constexpr ( std::is_same<U, bool>::value ) {
+         v ? out.append( "true", 4 ) : out.append( "false", 5 );
+      } else if constexpr ( std::is_same<U, char>::value ) {
+         out.append( &v, 1 );
+      } else if constexpr ( std::is_integral<U>::value && sizeof(U) <= sizeof(uint64_t) ) {
+         bool negative = false;
+         if constexpr ( std::is_signed<U>::value )
+            negative = v < 0;
+         const uint64_t abs = negative ? uint64_t(0) - uint64_t(v) : uint64_t(v);
+         constexpr size_t max_size = 21; // 20 digits and a minus sign
+         char* begin = out.reserve( max_size );
+         out.commit( write_decimal( begin, begin + max_size, false, abs, 0, negative ) - begin );
+      } else if constexpr ( std::is_same<U, const char*>::value || std::is_same<U, char*>::value ) {
+         out.append( v, strlen( v ) );
+      } else if constexpr ( std::is_same<U, std::string>::value || std::is_same<U, std::string_view>::value ) {
+         out.append( v.data(), v.size() );
+      } else if constexpr ( _print_detail::has_write_as_string<U>::value ) {
+         char* begin = out.reserve( 0 );
+         const size_t size = v.write_as_string( begin, begin, true ) - begin;
+         if( size > print_buffer::capacity ) {
+            out.flush();
+            print( v );
+            return;
+         }
+         begin = out.reserve( size );
+         out.commit( v.write_as_string( begin, begin + size ) - begin );
+      } else if constexpr ( _print_detail::has_byte_array<U>::value ) {
+         static const char* hex_characters = "0123456789abcdef";
+         const auto bytes = v.extract_as_byte_array();
+         if( 2 * bytes.size() > print_buffer::capacity ) {
+            out.flush();
+            print( v );
+            return;
+         }
+         char* p = out.reserve( 2 * bytes.size() );
+         for( uint8_t b : bytes ) {
+            *p++ = hex_characters[b >> 4];
+            *p++ = hex_characters[b & 0xf];
+         }
+         out.commit( 2 * bytes.size() );
+      } else {
+         out.flush();
+         print( v );
+      }
+   }
+
+   namespace _print_detail {
+      inline void format( print_buffer& out, const char* s ) {
+         out.append( s, strlen( s ) );
+      }
+
+      // appends the text up to the next %, which is replaced by the next value
+      template<typename Arg, typename... Args>
+      void format( print_buffer& out, const char* s, const Arg& val, const Args&... rest ) {
+         const char* p = s;
+         while( *p != '\0' && *p != '%' )
+            ++p;
+         out.append( s, p - s );
+         if( *p == '%' ) {
+            print_to( out, val );
+            format( out, p + 1, rest... );
+         }
+      }
+   }
+
    /**
     *  Prints null terminated string
     *
@@ -198,15 +359,8 @@ namespace sysio {
     */
    template <typename Arg, typename... Args>
    inline void print_f( const char* s, Arg val, Args... rest ) {
-      while ( *s != '\0' ) {
-         if ( *s == '%' ) {
-            print( val );
-            print_f( s+1, rest... );
-            return;
-         }
-         internal_use_do_not_use::prints_l( s, 1 );
-         s++;
-      }
+      print_buffer out;
+      _print_detail::format( out, s, val, rest... );
    }
 
     /**
@@ -230,8 +384,9 @@ namespace sysio {
      */
    template<typename Arg, typename... Args>
    void print( Arg&& a, Args&&... args ) {
-      print(std::forward<Arg>(a));
-      print(std::forward<Args>(args)...);
+      print_buffer out;
+      print_to( out, a );
+      ( print_to( out, args ), ... );
    }
 
    /**
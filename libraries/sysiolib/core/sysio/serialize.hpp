@@ -1,8 +1,46 @@
+#pragma once
 #include <bluegrass/meta/preprocessor.hpp>
 
+#include <type_traits>
+#include <utility>
+
+namespace sysio { namespace _serialize_detail {
+   /*
+    * Checks whether Member, a generic lambda returning the address of a member, can be called with a T*.
+    * Taking the address of a bit-field is ill-formed, so it yields false for bit-fields instead of a hard error.
+    */
+   template<typename T, typename Member>
+   constexpr bool is_addressable( Member ) {
+      return std::is_invocable_v<Member, T*>;
+   }
+
+   /*
+    * Makes T dependent on Dep, so that names looked up in T are only checked when the template is instantiated
+    */
+   template<typename T, typename Dep>
+   struct dependent_type { using type = T; };
+
+   /*
+    * Check if type T has an accessible `_syslib_for_each_member`
+    *
+    * @tparam T - The type to be checked
+    */
+   template<typename T, typename = void>
+   struct has_member_visitor : std::false_type {};
+   template<typename T>
+   struct has_member_visitor<T, std::void_t<decltype(T::_syslib_for_each_member(std::declval<void(*)(int)>()))>>
+      : std::true_type {};
+}} // namespace sysio::_serialize_detail
+
 #define SYSLIB_REFLECT_MEMBER_OP( OP, elem ) \
   OP t.elem
 
+#define SYSLIB_REFLECT_MEMBER_PTR( TYPE, elem ) \
+  f( &TYPE::elem );
+
+#define SYSLIB_REFLECT_MEMBER_ADDRESSABLE( TYPE, elem ) \
+  && ::sysio::_serialize_detail::is_addressable<TYPE>( []( auto* p ) -> decltype( &std::remove_pointer_t<decltype(p)>::elem ) { return nullptr; } )
+
 /**
  *  @defgroup serialize Serialize
  *  @ingroup core
@@ -12,6 +50,11 @@
 /**
  *  Defines serialization and deserialization for a class
  *
+ *  Also defines `_syslib_for_each_member(f)`, which calls `f` with a pointer to each serialized member in
+ *  serialization order, so that single fields can be located in the serialized form and the packed size of
+ *  fixed layout types can be computed at compile time. It is only available when every member is addressable,
+ *  so classes with bit-field members still serialize but are not visited.
+ *
  *  @ingroup serialize
  *  @param TYPE - the class to have its serialization and deserialization defined
  *  @param MEMBERS - a sequence of member names.  (field1)(field2)(field3)
@@ -24,12 +67,23 @@
  template<typename DataStream> \
  friend DataStream& operator >> ( DataStream& ds, TYPE& t ){ \
     return ds BLUEGRASS_META_FOREACH_SEQ( SYSLIB_REFLECT_MEMBER_OP, >>, MEMBERS );\
+ }\
+ using _syslib_serialized_type = TYPE; \
+ template<typename T_> \
+ static constexpr bool _syslib_members_addressable(){ \
+    return true BLUEGRASS_META_FOREACH_SEQ( SYSLIB_REFLECT_MEMBER_ADDRESSABLE, T_, MEMBERS ); \
+ } \
+ template<typename F, typename T_ = TYPE, std::enable_if_t<_syslib_members_addressable<T_>(), int> = 0> \
+ static constexpr void _syslib_for_each_member( F&& f ){ \
+    BLUEGRASS_META_FOREACH_SEQ( SYSLIB_REFLECT_MEMBER_PTR, T_, MEMBERS ) \
  }
 
 /**
  *  Defines serialization and deserialization for a class which inherits from other classes that
  *  have their serialization and deserialization defined
  *
+ *  `_syslib_for_each_member(f)` is only defined when the base has an accessible one as well.
+ *
  *  @ingroup serialize
  *  @param TYPE - the class to have its serialization and deserialization defined
  *  @param BASE - a sequence of base class names (basea)(baseb)(basec)
@@ -45,4 +99,15 @@
  friend DataStream& operator >> ( DataStream& ds, TYPE& t ){ \
     ds >> static_cast<BASE&>(t); \
     return ds BLUEGRASS_META_FOREACH_SEQ( SYSLIB_REFLECT_MEMBER_OP, >>, MEMBERS );\
+ }\
+ using _syslib_serialized_type = TYPE; \
+ template<typename T_> \
+ static constexpr bool _syslib_members_addressable(){ \
+    return ::sysio::_serialize_detail::has_member_visitor<typename ::sysio::_serialize_detail::dependent_type<BASE, T_>::type>::value \
+       BLUEGRASS_META_FOREACH_SEQ( SYSLIB_REFLECT_MEMBER_ADDRESSABLE, T_, MEMBERS ); \
+ } \
+ template<typename F, typename T_ = TYPE, std::enable_if_t<_syslib_members_addressable<T_>(), int> = 0> \
+ static constexpr void _syslib_for_each_member( F&& f ){ \
+    ::sysio::_serialize_detail::dependent_type<BASE, T_>::type::_syslib_for_each_member( f ); \
+    BLUEGRASS_META_FOREACH_SEQ( SYSLIB_REFLECT_MEMBER_PTR, T_, MEMBERS ) \
  }
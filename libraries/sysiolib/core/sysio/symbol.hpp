@@ -296,15 +296,34 @@ namespace sysio {
 
       constexpr explicit operator bool()const { return value != 0; }
 
+      /**
+       *  Writes the symbol as a string to the provided char buffer, as its precision, a comma and its code
+       *
+       *  @param begin - The start of the char buffer
+       *  @param end - Just past the end of the char buffer
+       *  @param dry_run - If true, do not actually write anything into the range.
+       *  @param show_precision - Whether to write the precision and the comma
+       *  @return char* - Just past the end of the last character that would be written assuming dry_run == false and end was large enough to provide sufficient space.
+       *  @post If the output string fits within the range [begin, end) and dry_run == false, the range [begin, returned pointer) contains the string representation of the symbol. Nothing is written if dry_run == true or returned pointer > end (insufficient space).
+       */
+      char* write_as_string( char* begin, char* end, bool dry_run = false, bool show_precision = true )const {
+         char* start_of_code = show_precision ? write_decimal( begin, end, true, precision(), 0, false ) + 1 : begin;
+         char* actual_end = code().write_as_string( start_of_code, end, true );
+         if( dry_run || (actual_end < begin) || (actual_end > end) ) return actual_end;
+
+         if( show_precision ) {
+            write_decimal( begin, end, false, precision(), 0, false );
+            *(start_of_code - 1) = ',';
+         }
+         return code().write_as_string( start_of_code, end );
+      }
+
       /**
        * %Print the symbol
        */
       void print( bool show_precision = true )const {
-         if( show_precision ){
-            ::sysio::print( static_cast<uint64_t>(precision()), "," );
-         }
-         char buffer[7];
-         auto end = code().write_as_string( buffer, buffer + sizeof(buffer) );
+         char buffer[11]; // up to 3 digits of precision, a comma and 7 characters of code
+         auto end = write_as_string( buffer, buffer + sizeof(buffer), false, show_precision );
          if( buffer < end )
             printl( buffer, (end-buffer) );
       }
@@ -373,6 +392,16 @@ namespace sysio {
      return ds;
    }
 
+   /// @cond IMPLEMENTATIONS
+
+   template<>
+   struct fixed_pack_size<symbol_code> : std::integral_constant<size_t, sizeof(uint64_t)> {};
+
+   template<>
+   struct fixed_pack_size<symbol> : std::integral_constant<size_t, sizeof(uint64_t)> {};
+
+   /// @endcond
+
    /**
     *  Extended asset which stores the information of the owner of the symbol
     *
@@ -415,8 +444,9 @@ namespace sysio {
        * @brief %Print the extended symbol
        */
       void print( bool show_precision = true )const {
-         sym.print( show_precision );
-         ::sysio::print("@", contract);
+         char buffer[11];
+         auto end = sym.write_as_string( buffer, buffer + sizeof(buffer), false, show_precision );
+         ::sysio::print( std::string_view( buffer, end - buffer ), "@", contract );
       }
 
       /**
@@ -3,8 +3,86 @@
  *  @copyright defined in eos/LICENSE
  */
 #pragma once
+#include "check.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+#include <utility>
 
 namespace sysio {
+   namespace _varint_detail {
+      /**
+       * The number of bytes the varint encoding of `v` takes
+       *
+       * @param v - The value to encode
+       * @return size_t - Between 1 and 5
+       */
+      constexpr size_t varuint32_size( uint32_t v ) {
+         return v < (1u << 7) ? 1 : v < (1u << 14) ? 2 : v < (1u << 21) ? 3 : v < (1u << 28) ? 4 : 5;
+      }
+
+      /**
+       * Writes the varint encoding of `v` with a single write of all of its bytes
+       *
+       * @param ds - The stream to write
+       * @param v - The value to encode
+       */
+      template<typename DataStream>
+      void write_varuint32( DataStream& ds, uint32_t v ) {
+         const size_t size = varuint32_size( v );
+         char buffer[5];
+         for( size_t i = 0; i + 1 < size; ++i, v >>= 7 )
+            buffer[i] = char( v | 0x80 );
+         buffer[size - 1] = char( v );
+         ds.write( buffer, size );
+      }
+
+      template<typename DataStream, typename = void>
+      struct has_buffer : std::false_type {};
+      template<typename DataStream>
+      struct has_buffer<DataStream, std::void_t<decltype(*std::declval<DataStream&>().pos()),
+                                                decltype(std::declval<DataStream&>().remaining())>> : std::true_type {};
+
+      /**
+       * Reads a varint encoded value. The one and two byte encodings, which cover every value below 16384 and so
+       * nearly every size prefix, are decoded straight from the buffer of the stream when it has one. Encodings of
+       * more than 5 bytes or of more than 32 bits are rejected.
+       *
+       * @param ds - The stream to read
+       * @return uint32_t - The decoded value
+       */
+      template<typename DataStream>
+      uint32_t read_varuint32( DataStream& ds ) {
+         if constexpr ( has_buffer<DataStream>::value ) {
+            if( ds.remaining() >= 2 ) {
+               const uint8_t* p = (const uint8_t*)ds.pos();
+               if( !(p[0] & 0x80) ) {
+                  ds.skip( 1 );
+                  return p[0];
+               }
+               if( !(p[1] & 0x80) ) {
+                  ds.skip( 2 );
+                  return (p[0] & 0x7f) | uint32_t( p[1] ) << 7;
+               }
+            }
+         }
+         uint32_t v = 0;
+         for( uint32_t by = 0; by < 35; by += 7 ) {
+            char c = 0;
+            ds.get( c );
+            const uint8_t b = uint8_t( c );
+            v |= uint32_t( b & 0x7f ) << by;
+            if( !(b & 0x80) ) {
+               sysio::check( by < 28 || b < 0x10, "varint is larger than 32 bits" );
+               return v;
+            }
+         }
+         sysio::check( false, "varint is longer than 5 bytes" );
+         return v;
+      }
+   }
+
    /**
     * @defgroup varint Variable Length Integer Type
     * @ingroup core
@@ -203,13 +281,7 @@ namespace sysio {
         */
        template<typename DataStream>
        friend DataStream& operator << ( DataStream& ds, const unsigned_int& v ){
-          uint64_t val = v.value;
-          do {
-             uint8_t b = uint8_t(val) & 0x7f;
-             val >>= 7;
-             b |= ((val > 0) << 7);
-             ds.write((char*)&b,1);//.put(b);
-          } while( val );
+          _varint_detail::write_varuint32( ds, v.value );
           return ds;
        }
 
@@ -223,13 +295,7 @@ namespace sysio {
         */
        template<typename DataStream>
        friend DataStream& operator >> ( DataStream& ds, unsigned_int& vi ){
-         uint64_t v = 0; char b = 0; uint8_t by = 0;
-         do {
-            ds.get(b);
-            v |= uint32_t(uint8_t(b) & 0x7f) << by;
-            by += 7;
-         } while( uint8_t(b) & 0x80 );
-         vi.value = static_cast<uint32_t>(v);
+         vi.value = _varint_detail::read_varuint32( ds );
          return ds;
        }
 
@@ -430,14 +496,8 @@ namespace sysio {
         */
        template<typename DataStream>
        friend DataStream& operator << ( DataStream& ds, const signed_int& v ){
-         uint32_t val = uint32_t((v.value<<1) ^ (v.value>>31));
-         do {
-            uint8_t b = uint8_t(val) & 0x7f;
-            val >>= 7;
-            b |= ((val > 0) << 7);
-            ds.write((char*)&b,1);//.put(b);
-         } while( val );
-          return ds;
+         _varint_detail::write_varuint32( ds, (uint32_t(v.value) << 1) ^ uint32_t(v.value >> 31) );
+         return ds;
        }
 
        /**
@@ -450,12 +510,7 @@ namespace sysio {
         */
        template<typename DataStream>
        friend DataStream& operator >> ( DataStream& ds, signed_int& vi ){
-         uint32_t v = 0; char b = 0; int by = 0;
-         do {
-            ds.get(b);
-            v |= uint32_t(uint8_t(b) & 0x7f) << by;
-            by += 7;
-         } while( uint8_t(b) & 0x80 );
+         const uint32_t v = _varint_detail::read_varuint32( ds );
          vi.value = (v>>1) ^ (~(v&1)+1ull);
          return ds;
        }
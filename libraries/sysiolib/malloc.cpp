@@ -518,7 +518,8 @@ namespace sysio {
       size_t _heaps_actual_size;
       size_t _active_heap;
       size_t _active_free_heap;
-      static const size_t _alloc_memory_mask = size_t(1) << 31;
+      // the top bit, so that native heaps can hold blocks of more than 2 GiB
+      static const size_t _alloc_memory_mask = size_t(1) << (sizeof(size_t) * 8 - 1);
    };
 
    memory_manager memory_heap;
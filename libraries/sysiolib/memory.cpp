@@ -1,31 +1,90 @@
 #include <cstring>
+#include <cstdint>
+
+namespace {
+   // word accesses may alias any object and the source side of a copy may be unaligned
+   typedef uint64_t __attribute__((__may_alias__))                 word_t;
+   typedef uint64_t __attribute__((__may_alias__, __aligned__(1))) unaligned_word_t;
+
+   constexpr size_t word_size = sizeof(word_t);
+
+   inline bool is_word_aligned( const void* ptr ) {
+      return ((uintptr_t)ptr & (word_size-1)) == 0;
+   }
+
+#ifndef __wasm_bulk_memory__
+   inline void copy_forward( uint8_t* dst, const uint8_t* src, size_t n ) {
+      for ( ; n && !is_word_aligned(dst); --n )
+         *dst++ = *src++;
+      for ( ; n >= word_size; n -= word_size, dst += word_size, src += word_size )
+         *(word_t*)dst = *(const unaligned_word_t*)src;
+      for ( ; n; --n )
+         *dst++ = *src++;
+   }
+
+   inline void copy_backward( uint8_t* dst, const uint8_t* src, size_t n ) {
+      dst += n;
+      src += n;
+      for ( ; n && !is_word_aligned(dst); --n )
+         *--dst = *--src;
+      for ( ; n >= word_size; n -= word_size ) {
+         dst -= word_size;
+         src -= word_size;
+         *(word_t*)dst = *(const unaligned_word_t*)src;
+      }
+      for ( ; n; --n )
+         *--dst = *--src;
+   }
+#endif
+}
 
 extern "C" {
+#ifdef __wasm_bulk_memory__
+   // with -mbulk-memory these lower to a single memory.fill/memory.copy, which also handles overlap
+   void* memset( void* ptr, int c, size_t n ) {
+      return __builtin_memset( ptr, c, n );
+   }
+   void* memcpy( void* ptr1, const void* ptr2, size_t n ) {
+      return __builtin_memcpy( ptr1, ptr2, n );
+   }
+   void* memmove( void* ptr1, const void* ptr2, size_t n ) {
+      return __builtin_memmove( ptr1, ptr2, n );
+   }
+#else
    void* memset( void* ptr, int c, size_t n ) {
       uint8_t* p = (uint8_t*)ptr;
-      for ( size_t i=0; i < n; i++ )
-         p[i] = (uint8_t)c;
+      for ( ; n && !is_word_aligned(p); --n )
+         *p++ = (uint8_t)c;
+      const word_t w = (uint8_t)c * 0x0101010101010101ULL;
+      for ( ; n >= word_size; n -= word_size, p += word_size )
+         *(word_t*)p = w;
+      for ( ; n; --n )
+         *p++ = (uint8_t)c;
       return ptr;
    }
    void* memcpy( void* ptr1, const void* ptr2, size_t n ) {
-      uint8_t* p1 = (uint8_t*)ptr1;
-      const uint8_t* p2 = (const uint8_t*)ptr2;
-      for ( size_t i=0; i < n; i++ )
-         p1[i] = p2[i];
+      copy_forward( (uint8_t*)ptr1, (const uint8_t*)ptr2, n );
       return ptr1;
    }
    void* memmove( void* ptr1, const void* ptr2, size_t n ) {
       uint8_t* p1 = (uint8_t*)ptr1;
       const uint8_t* p2 = (const uint8_t*)ptr2;
-      uint8_t* p3 = new uint8_t[n];
-      memcpy( p3, p2, n );
-      memcpy( p1, p3, n );
-      delete[] p3;
+      // a forward copy is safe unless the destination starts inside the source range
+      if ( p1 <= p2 || p1 >= p2 + n )
+         copy_forward( p1, p2, n );
+      else
+         copy_backward( p1, p2, n );
       return ptr1;
    }
+#endif
    int memcmp( const void* ptr1, const void* ptr2, size_t n ) {
       const uint8_t* p1 = (uint8_t*)ptr1;
       const uint8_t* p2 = (uint8_t*)ptr2;
+      // skip over equal words, the byte loop below locates the first difference
+      for ( ; n >= word_size; n -= word_size, p1 += word_size, p2 += word_size ) {
+         if ( *(const unaligned_word_t*)p1 != *(const unaligned_word_t*)p2 )
+            break;
+      }
       for ( size_t i=0; i < n; i++ ) {
          if ( p1[i] < p2[i] )
             return -1;
@@ -0,0 +1,344 @@
+#include <cstdlib>
+#include <cstring>
+#include "core/sysio/check.hpp"
+#include "core/sysio/heap_stats.hpp"
+
+#ifdef SYSIO_NATIVE
+   extern "C" {
+      size_t _current_memory();
+      size_t _grow_memory(size_t);
+   }
+#define CURRENT_MEMORY _current_memory()
+#define GROW_MEMORY(X) _grow_memory(X)
+#else
+#define CURRENT_MEMORY __builtin_wasm_memory_size(0)
+#define GROW_MEMORY(X) __builtin_wasm_memory_grow(0, X)
+#endif
+
+namespace sysio {
+#ifdef SYSIO_NATIVE
+   extern "C" uintptr_t __get_heap_base();
+#endif
+
+   /**
+    * Segregated free list allocator.
+    *
+    * Every chunk starts with an 8 byte header holding its size, a multiple of 16, and its state in the low bits.
+    * Chunks are laid out so that the payload after the header is 16 byte aligned.
+    * Free chunks of up to max_small_chunk bytes are kept in one list per size class, larger ones in one list per power
+    * of two, and a bitmap of the non-empty lists finds the smallest one that can serve a request in O(1).
+    * A free chunk also keeps its size in its last word and flags its successor, so a released chunk is merged with free
+    * neighbours on both sides and with the top of the heap.
+    * New chunks are carved from the top of the heap, which is grown a WASM page at a time.
+    */
+   class size_class_allocator {
+      public:
+         void* malloc(size_t size) {
+            if (size == 0)
+               return nullptr;
+            init();
+
+            const size_t needed = chunk_size(size);
+            char* c = take_free(needed);
+            if (!c)
+               c = take_top(needed);
+
+            mark_used(c);
+            ++_stats.malloc_count;
+            return payload(c);
+         }
+
+         void* realloc(void* ptr, size_t size) {
+            if (ptr == nullptr)
+               return malloc(size);
+            if (size == 0) {
+               free(ptr);
+               return nullptr;
+            }
+
+            char* c = chunk(ptr);
+            sysio::check(state_of(c) == used, "realloc of a pointer that is not allocated");
+            const size_t current = size_of(c);
+            const size_t needed  = chunk_size(size);
+
+            if (needed <= current) {
+               shrink(c, needed);
+               ++_stats.realloc_in_place_count;
+               return ptr;
+            }
+            if (grow_in_place(c, needed)) {
+               ++_stats.realloc_in_place_count;
+               return ptr;
+            }
+
+            void* result = malloc(size);
+            memcpy(result, ptr, current - header_size);
+            free(ptr);
+            return result;
+         }
+
+         void free(void* ptr) {
+            if (ptr == nullptr)
+               return;
+
+            char* c = chunk(ptr);
+            sysio::check(state_of(c) == used, "free of a pointer that is not allocated");
+            const size_t size = size_of(c);
+            _stats.allocated_bytes -= size;
+            ++_stats.free_count;
+            release(c, size);
+         }
+
+         heap_stats stats() {
+            init();
+            heap_stats result = _stats;
+            result.heap_bytes = _top - _start;
+            return result;
+         }
+
+      private:
+         static constexpr size_t   wasm_page_size  = 64*1024;
+         static constexpr size_t   alignment       = 16;
+         static constexpr size_t   header_size     = 8;
+         // room for the header, the list links and the trailing size of a free chunk
+         static constexpr size_t   min_chunk       = 32;
+         static constexpr size_t   max_small_chunk = 512;
+         static constexpr size_t   small_classes   = max_small_chunk / alignment;
+         static constexpr uint32_t min_large_log2  = 9;
+         static constexpr size_t   large_classes   = 32;
+         static constexpr size_t   classes         = small_classes + large_classes;
+
+         // chunk state and flags kept in the low bits of the header
+         static constexpr size_t free_chunk = 0;
+         static constexpr size_t used       = 1;
+         static constexpr size_t state_mask = 1;
+         // set when the preceding chunk is free, its size is then stored in the word before this header
+         static constexpr size_t prev_free  = 2;
+         static constexpr size_t flag_mask  = alignment - 1;
+
+         struct free_links {
+            char* prev;
+            char* next;
+         };
+
+         static size_t& head(char* c)                  { return *reinterpret_cast<size_t*>(c); }
+         static size_t  size_of(char* c)               { return head(c) & ~flag_mask; }
+         static size_t  state_of(char* c)              { return head(c) & state_mask; }
+         static void    init_head(char* c, size_t size, size_t state) { head(c) = size | state; }
+         static void    set_head(char* c, size_t size, size_t state) { head(c) = size | state | (head(c) & prev_free); }
+         static size_t& footer(char* c, size_t size)   { return *reinterpret_cast<size_t*>(c + size - sizeof(size_t)); }
+         static char*   payload(char* c)               { return c + header_size; }
+         static char*   chunk(void* p)                 { return static_cast<char*>(p) - header_size; }
+         static free_links& links(char* c)             { return *reinterpret_cast<free_links*>(payload(c)); }
+
+         static size_t chunk_size(size_t size) {
+            sysio::check(size <= SIZE_MAX - header_size - alignment, "malloc size is too large");
+            const size_t s = (size + header_size + alignment - 1) & ~(alignment - 1);
+            return s < min_chunk ? min_chunk : s;
+         }
+
+         static size_t class_of(size_t size) {
+            if (size <= max_small_chunk)
+               return size / alignment - 1;
+            const size_t log2 = sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(size);
+            const size_t bin  = log2 - min_large_log2;
+            return small_classes + (bin < large_classes ? bin : large_classes - 1);
+         }
+
+         void init() {
+            if (_initialized)
+               return;
+            _pages = CURRENT_MEMORY;
+#ifdef SYSIO_NATIVE
+            _base = reinterpret_cast<char*>(__get_heap_base());
+            char* heap_base = _base;
+#else
+            _base = nullptr;
+            volatile uintptr_t heap_base_ptr = 0; // linker places the heap base at address 0
+            char* heap_base = *(char**)heap_base_ptr;
+#endif
+            // the heap starts in the free part of the initial pages, which are only grown once it runs past them.
+            // Chunks start 8 bytes past a 16 byte boundary so that payloads are 16 byte aligned
+            _start = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(heap_base) + alignment - 1) & ~uintptr_t(alignment - 1)) + header_size;
+            _top   = _start;
+            _initialized = true;
+         }
+
+         void mark_used(char* c) {
+            const size_t size = size_of(c);
+            set_head(c, size, used);
+            _stats.allocated_bytes += size;
+            if (_stats.allocated_bytes > _stats.peak_allocated_bytes)
+               _stats.peak_allocated_bytes = _stats.allocated_bytes;
+         }
+
+         void reserve_top(size_t size) {
+            const size_t end = (_top - _base) + size;
+            const size_t pages_needed = (end + wasm_page_size - 1) / wasm_page_size;
+            if (pages_needed > _pages) {
+               sysio::check(GROW_MEMORY(pages_needed - _pages) != -1, "failed to allocate pages");
+               _stats.pages_grown += pages_needed - _pages;
+               _pages = pages_needed;
+            }
+         }
+
+         char* take_top(size_t size) {
+            reserve_top(size);
+            char* c = _top;
+            _top += size;
+            init_head(c, size, used);
+            return c;
+         }
+
+         char* take_free(size_t size) {
+            // a small class holds chunks of exactly this size, a large one needs a first fit search
+            const size_t cls = class_of(size);
+            char* c = _free[cls];
+            while (c && size_of(c) < size)
+               c = links(c).next;
+            if (!c) {
+               const uint64_t larger = cls + 1 < classes ? _free_bitmap >> (cls + 1) : 0;
+               if (larger == 0)
+                  return nullptr;
+               c = _free[cls + 1 + __builtin_ctzll(larger)];
+            }
+            unlink_free(c);
+            split(c, size);
+            return c;
+         }
+
+         void insert_free(char* c, size_t size) {
+            set_head(c, size, free_chunk);
+            footer(c, size) = size;
+            head(c + size) |= prev_free;
+            const size_t cls = class_of(size);
+            links(c).prev = nullptr;
+            links(c).next = _free[cls];
+            if (_free[cls])
+               links(_free[cls]).prev = c;
+            _free[cls] = c;
+            _free_bitmap |= uint64_t(1) << cls;
+            _stats.free_bytes += size;
+         }
+
+         void unlink_free(char* c) {
+            const size_t size = size_of(c);
+            const size_t cls  = class_of(size);
+            auto& l = links(c);
+            if (l.prev)
+               links(l.prev).next = l.next;
+            else
+               _free[cls] = l.next;
+            if (l.next)
+               links(l.next).prev = l.prev;
+            if (!_free[cls])
+               _free_bitmap &= ~(uint64_t(1) << cls);
+            head(c + size) &= ~prev_free;
+            _stats.free_bytes -= size;
+         }
+
+         // give the tail of an oversized chunk back to the free lists
+         void split(char* c, size_t size) {
+            const size_t current = size_of(c);
+            if (current - size < min_chunk)
+               return;
+            set_head(c, size, state_of(c));
+            init_head(c + size, current - size, used);
+            release(c + size, current - size);
+         }
+
+         void shrink(char* c, size_t size) {
+            const size_t current = size_of(c);
+            if (current - size < min_chunk)
+               return;
+            _stats.allocated_bytes -= current - size;
+            split(c, size);
+         }
+
+         bool grow_in_place(char* c, size_t size) {
+            const size_t current = size_of(c);
+            char* next = c + current;
+            size_t available = current;
+            if (next != _top && state_of(next) == free_chunk) {
+               available += size_of(next);
+               next = c + available;
+            }
+            if (available < size && next != _top)
+               return false;
+
+            if (available != current)
+               unlink_free(c + current);
+            if (available < size) {
+               reserve_top(size - available);
+               _top = c + size;
+               available = size;
+            }
+
+            set_head(c, available, used);
+            _stats.allocated_bytes += available - current;
+            if (_stats.allocated_bytes > _stats.peak_allocated_bytes)
+               _stats.peak_allocated_bytes = _stats.allocated_bytes;
+            shrink(c, size);
+            return true;
+         }
+
+         void release(char* c, size_t size) {
+            if (head(c) & prev_free) {
+               const size_t prev_size = *reinterpret_cast<size_t*>(c - sizeof(size_t));
+               c -= prev_size;
+               size += prev_size;
+               unlink_free(c);
+            }
+            char* next = c + size;
+            if (next != _top && state_of(next) == free_chunk) {
+               unlink_free(next);
+               size += size_of(next);
+            }
+            if (c + size == _top) {
+               _top = c;
+               return;
+            }
+            insert_free(c, size);
+         }
+
+         bool       _initialized;
+         char*      _base;
+         char*      _start;
+         char*      _top;
+         size_t     _pages;
+         char*      _free[classes];
+         uint64_t   _free_bitmap;
+         heap_stats _stats;
+   };
+
+   // zero initialized, the allocator sets itself up on first use
+   size_class_allocator _size_class_allocator;
+
+   heap_stats get_heap_stats() {
+      return _size_class_allocator.stats();
+   }
+} // ns sysio
+
+extern "C" {
+
+void* malloc(size_t size) {
+   return sysio::_size_class_allocator.malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+   sysio::check(size == 0 || count <= SIZE_MAX / size, "calloc size is too large");
+   if (void* ptr = sysio::_size_class_allocator.malloc(count*size)) {
+      memset(ptr, 0, count*size);
+      return ptr;
+   }
+   return nullptr;
+}
+
+void* realloc(void* ptr, size_t size) {
+   return sysio::_size_class_allocator.realloc(ptr, size);
+}
+
+void free(void* ptr) {
+   sysio::_size_class_allocator.free(ptr);
+}
+}
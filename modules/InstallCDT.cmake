@@ -74,6 +74,7 @@ cdt_tool_install_and_symlink(cdt-cpp cdt-cpp)
 cdt_tool_install_and_symlink(cdt-ld cdt-ld)
 cdt_tool_install_and_symlink(cdt-abidiff cdt-abidiff)
 cdt_tool_install_and_symlink(cdt-init cdt-init)
+cdt_tool_install_and_symlink(cdt-profile cdt-profile)
 
 cdt_clang_install(../lib/LLVMSysioApply${CMAKE_SHARED_LIBRARY_SUFFIX})
 cdt_clang_install(../lib/LLVMSysioSoftfloat${CMAKE_SHARED_LIBRARY_SUFFIX})
@@ -68,6 +68,7 @@ create_symlink sysio-wasm2wast cdt-wasm2wast
 create_symlink sysio-wast2wasm cdt-wast2wasm
 create_symlink cdt-ar cdt-ar
 create_symlink cdt-abidiff cdt-abidiff
+create_symlink cdt-profile cdt-profile
 create_symlink cdt-nm cdt-nm
 create_symlink cdt-objcopy cdt-objcopy
 create_symlink cdt-objdump cdt-objdump
@@ -0,0 +1,224 @@
+#include <boost/test/unit_test.hpp>
+#include <sysio/testing/tester.hpp>
+#include <sysio/chain/abi_serializer.hpp>
+
+#include <fc/variant_object.hpp>
+
+#include <contracts.hpp>
+
+using namespace sysio;
+using namespace sysio::testing;
+using namespace sysio::chain;
+using namespace fc;
+
+using mvo = fc::mutable_variant_object;
+
+// These cases report the wall time the chain spent executing each action so that
+// regressions in the library hot paths show up as the work size grows.
+BOOST_AUTO_TEST_SUITE(benchmark_tests)
+
+static fc::microseconds action_elapsed( const transaction_trace_ptr& trace ) {
+   BOOST_REQUIRE( trace && !trace->action_traces.empty() );
+   return trace->action_traces.front().elapsed;
+}
+
+BOOST_FIXTURE_TEST_CASE( multi_index_cache_bench, tester ) try {
+   create_accounts( { "bench"_n } );
+   produce_block();
+   set_code( "bench"_n, contracts::multi_index_bench_wasm() );
+   set_abi( "bench"_n, contracts::multi_index_bench_abi().data() );
+   produce_blocks();
+
+   for( uint32_t rows : { 100, 500, 1000, 2000 } ) {
+      auto find_trace = push_action( "bench"_n, "findbench"_n, "bench"_n, mvo()("scope", rows)("rows", rows) );
+      produce_block();
+      auto erase_trace = push_action( "bench"_n, "erasebench"_n, "bench"_n, mvo()("scope", rows)("rows", rows) );
+      produce_block();
+      BOOST_TEST_MESSAGE( "multi_index rows=" << rows
+                          << " find: " << action_elapsed( find_trace ).count() << "us"
+                          << " erase: " << action_elapsed( erase_trace ).count() << "us" );
+   }
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( multi_index_modify_bench, tester ) try {
+   create_accounts( { "bench"_n } );
+   produce_block();
+   set_code( "bench"_n, contracts::multi_index_bench_wasm() );
+   set_abi( "bench"_n, contracts::multi_index_bench_abi().data() );
+   produce_blocks();
+
+   uint64_t scope = 0;
+   for( uint32_t rows : { 10, 100 } ) {
+      for( uint32_t repeats : { 1, 5, 20 } ) {
+         auto immediate_trace = push_action( "bench"_n, "modifybench"_n, "bench"_n,
+                                             mvo()("scope", ++scope)("rows", rows)("repeats", repeats)("deferred", false) );
+         auto deferred_trace  = push_action( "bench"_n, "modifybench"_n, "bench"_n,
+                                             mvo()("scope", ++scope)("rows", rows)("repeats", repeats)("deferred", true) );
+         produce_block();
+         BOOST_TEST_MESSAGE( "multi_index modify rows=" << rows << " repeats=" << repeats
+                             << " immediate: " << action_elapsed( immediate_trace ).count() << "us"
+                             << " deferred: " << action_elapsed( deferred_trace ).count() << "us" );
+      }
+   }
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( multi_index_view_bench, tester ) try {
+   create_accounts( { "bench"_n } );
+   produce_block();
+   set_code( "bench"_n, contracts::multi_index_bench_wasm() );
+   set_abi( "bench"_n, contracts::multi_index_bench_abi().data() );
+   produce_blocks();
+
+   uint64_t scope = 0;
+   for( uint32_t rows : { 10, 100, 500 } ) {
+      auto args = mvo()("rows", rows)("repeats", 5);
+      auto full_trace = push_action( "bench"_n, "viewbench"_n, "bench"_n, mvo(args)("scope", ++scope)("view", false) );
+      auto view_trace = push_action( "bench"_n, "viewbench"_n, "bench"_n, mvo(args)("scope", ++scope)("view", true) );
+      produce_block();
+      BOOST_TEST_MESSAGE( "multi_index view rows=" << rows
+                          << " find: " << action_elapsed( full_trace ).count() << "us"
+                          << " find_view: " << action_elapsed( view_trace ).count() << "us" );
+   }
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( multi_index_range_bench, tester ) try {
+   create_accounts( { "bench"_n } );
+   produce_block();
+   set_code( "bench"_n, contracts::multi_index_bench_wasm() );
+   set_abi( "bench"_n, contracts::multi_index_bench_abi().data() );
+   produce_blocks();
+
+   uint64_t scope = 0;
+   for( uint32_t rows : { 10, 100, 1000 } ) {
+      auto rows_trace = push_action( "bench"_n, "rangebench"_n, "bench"_n, mvo()("scope", ++scope)("rows", rows)("keys_only", false) );
+      auto keys_trace = push_action( "bench"_n, "rangebench"_n, "bench"_n, mvo()("scope", ++scope)("rows", rows)("keys_only", true) );
+      produce_block();
+      BOOST_TEST_MESSAGE( "multi_index range rows=" << rows
+                          << " const_iterator: " << action_elapsed( rows_trace ).count() << "us"
+                          << " key_iterator: " << action_elapsed( keys_trace ).count() << "us" );
+   }
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( multi_index_fixed_row_bench, tester ) try {
+   create_accounts( { "bench"_n } );
+   produce_block();
+   set_code( "bench"_n, contracts::multi_index_bench_wasm() );
+   set_abi( "bench"_n, contracts::multi_index_bench_abi().data() );
+   produce_blocks();
+
+   uint64_t scope = 0;
+   for( uint32_t rows : { 10, 100, 500 } ) {
+      auto args = mvo()("rows", rows)("repeats", 5);
+      auto dynamic_trace = push_action( "bench"_n, "fixedbench"_n, "bench"_n, mvo(args)("scope", ++scope)("fixed", false) );
+      auto fixed_trace   = push_action( "bench"_n, "fixedbench"_n, "bench"_n, mvo(args)("scope", ++scope)("fixed", true) );
+      produce_block();
+      BOOST_TEST_MESSAGE( "multi_index fixed size rows=" << rows
+                          << " computed pack_size: " << action_elapsed( dynamic_trace ).count() << "us"
+                          << " constant pack_size: " << action_elapsed( fixed_trace ).count() << "us" );
+   }
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( multi_index_walk_bench, tester ) try {
+   create_accounts( { "bench"_n } );
+   produce_block();
+   set_code( "bench"_n, contracts::multi_index_bench_wasm() );
+   set_abi( "bench"_n, contracts::multi_index_bench_abi().data() );
+   produce_blocks();
+
+   for( uint32_t rows : { 1000, 10000 } ) {
+      for( uint32_t first = 0; first < rows; first += 1000 ) {
+         push_action( "bench"_n, "populate"_n, "bench"_n, mvo()("scope", rows)("first", first)("count", 1000) );
+         produce_block();
+      }
+      auto trace = push_action( "bench"_n, "walkbench"_n, "bench"_n, mvo()("scope", rows)("rows", rows) );
+      produce_block();
+      BOOST_TEST_MESSAGE( "multi_index walk rows=" << rows
+                          << " elapsed: " << action_elapsed( trace ).count() << "us "
+                          << trace->action_traces.front().console );
+   }
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( datastream_pack_bench, tester ) try {
+   create_accounts( { "bench"_n } );
+   produce_block();
+   set_code( "bench"_n, contracts::multi_index_bench_wasm() );
+   set_abi( "bench"_n, contracts::multi_index_bench_abi().data() );
+   produce_blocks();
+
+   for( uint32_t repeats : { 100, 1000, 10000 } ) {
+      auto checked_trace   = push_action( "bench"_n, "packbench"_n, "bench"_n, mvo()("repeats", repeats)("checked", true) );
+      auto unchecked_trace = push_action( "bench"_n, "packbench"_n, "bench"_n, mvo()("repeats", repeats)("checked", false) );
+      produce_block();
+      BOOST_TEST_MESSAGE( "datastream pack wide row repeats=" << repeats
+                          << " checked: " << action_elapsed( checked_trace ).count() << "us"
+                          << " unchecked: " << action_elapsed( unchecked_trace ).count() << "us" );
+   }
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( memory_functions_bench, tester ) try {
+   create_accounts( { "intrinsic"_n, "bulk"_n } );
+   produce_block();
+   set_code( "intrinsic"_n, contracts::memory_bench_wasm() );
+   set_abi( "intrinsic"_n, contracts::memory_bench_abi().data() );
+   set_code( "bulk"_n, contracts::memory_bench_bulk_wasm() );
+   set_abi( "bulk"_n, contracts::memory_bench_bulk_abi().data() );
+   produce_blocks();
+
+   for( uint32_t size : { 8, 64, 512, 4096, 32768 } ) {
+      auto args = mvo()("size", size)("iterations", 100);
+      auto intrinsic_trace = push_action( "intrinsic"_n, "membench"_n, "intrinsic"_n, args );
+      auto bulk_trace      = push_action( "bulk"_n, "membench"_n, "bulk"_n, args );
+      produce_block();
+      BOOST_TEST_MESSAGE( "memory size=" << size
+                          << " intrinsics: " << action_elapsed( intrinsic_trace ).count() << "us"
+                          << " bulk-memory: " << action_elapsed( bulk_trace ).count() << "us" );
+   }
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( malloc_bench, tester ) try {
+   create_accounts( { "dsm"_n, "freeing"_n, "sizeclass"_n } );
+   produce_block();
+   set_code( "dsm"_n, contracts::alloc_bench_wasm() );
+   set_abi( "dsm"_n, contracts::alloc_bench_abi().data() );
+   set_code( "freeing"_n, contracts::alloc_bench_freeing_wasm() );
+   set_abi( "freeing"_n, contracts::alloc_bench_freeing_abi().data() );
+   set_code( "sizeclass"_n, contracts::alloc_bench_scmalloc_wasm() );
+   set_abi( "sizeclass"_n, contracts::alloc_bench_scmalloc_abi().data() );
+   produce_blocks();
+
+   for( uint32_t live : { 16, 128, 1024 } ) {
+      auto args = mvo()("live", live)("rounds", 8);
+      std::string report = "malloc live=" + std::to_string(live);
+      for( auto account : { "dsm"_n, "freeing"_n, "sizeclass"_n } ) {
+         auto trace = push_action( account, "allocbench"_n, account, args );
+         report += " " + account.to_string() + ": " + std::to_string( action_elapsed( trace ).count() ) + "us "
+                 + trace->action_traces.front().console;
+      }
+      produce_block();
+      BOOST_TEST_MESSAGE( report );
+   }
+} FC_LOG_AND_RETHROW()
+
+BOOST_FIXTURE_TEST_CASE( action_dispatch_bench, tester ) try {
+   create_accounts( { "dispatch"_n } );
+   produce_block();
+   set_code( "dispatch"_n, contracts::dispatch_bench_wasm() );
+   set_abi( "dispatch"_n, contracts::dispatch_bench_abi().data() );
+   produce_blocks();
+
+   // the actions are empty, so the elapsed time is the dispatch. With a search over the action names the first and
+   // the last of the 52 actions cost the same
+   constexpr uint64_t pushes = 20;
+   std::string report = "action dispatch over " + std::to_string(pushes) + " pushes";
+   for( auto action : { "da"_n, "dz"_n, "ez"_n } ) {
+      int64_t elapsed = 0;
+      for( uint64_t nonce = 0; nonce < pushes; ++nonce ) {
+         elapsed += action_elapsed( push_action( "dispatch"_n, action, "dispatch"_n, mvo()("nonce", nonce) ) ).count();
+      }
+      produce_block();
+      report += " " + action.to_string() + ": " + std::to_string( elapsed ) + "us";
+   }
+   BOOST_TEST_MESSAGE( report );
+} FC_LOG_AND_RETHROW()
+
+BOOST_AUTO_TEST_SUITE_END()
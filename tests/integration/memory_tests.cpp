@@ -30,4 +30,18 @@ BOOST_FIXTURE_TEST_CASE( malloc_tests, tester ) try {
                           sysio_assert_message_is("failed to allocate pages") );
 } FC_LOG_AND_RETHROW()
 
+BOOST_FIXTURE_TEST_CASE( size_class_malloc_tests, tester ) try {
+   create_accounts( { "test"_n } );
+   produce_block();
+   set_code( "test"_n, contracts::scmalloc_tests_wasm() );
+   set_abi( "test"_n, contracts::scmalloc_tests_abi().data() );
+   produce_blocks();
+
+   push_action("test"_n, "mallocpass"_n, "test"_n, {});
+   push_action("test"_n, "mallocalign"_n, "test"_n, {});
+   BOOST_CHECK_EXCEPTION( push_action("test"_n, "mallocfail"_n, "test"_n, {}),
+                          sysio_assert_message_exception,
+                          sysio_assert_message_is("failed to allocate pages") );
+} FC_LOG_AND_RETHROW()
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,25 @@
+#include <sysio/sysio.hpp>
+#include <span>
+#include <string_view>
+
+using namespace sysio;
+
+class [[sysio::contract("borrowed_action_args")]] borrowed_action_args : public contract {
+public:
+   using contract::contract;
+
+   [[sysio::action]] void memo(name user, std::string_view memo) {
+      require_auth(user);
+      check(memo.size() <= 256, "memo has more than 256 bytes");
+   }
+
+   [[sysio::action]] void blob(name user, bytes_view data) {
+      require_auth(user);
+      check(!data.empty(), "empty blob");
+   }
+
+   [[sysio::action]] void raw(name user, std::span<const char> data) {
+      require_auth(user);
+      check(!data.empty(), "empty data");
+   }
+};
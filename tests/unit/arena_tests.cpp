@@ -0,0 +1,143 @@
+/**
+ *  @file
+ *  @copyright defined in sysio.cdt/LICENSE.txt
+ */
+
+#include <string>
+#include <vector>
+
+#include <sysio/tester.hpp>
+#include <sysio/arena.hpp>
+#include <sysio/datastream.hpp>
+
+using std::string;
+using std::vector;
+
+using sysio::arena;
+using sysio::arena_bytes;
+using sysio::arena_vector;
+using sysio::datastream;
+using sysio::pack;
+using sysio::unpack;
+
+static bool in_buffer( const void* p, const char* buffer, size_t size ) {
+   return (const char*)p >= buffer && (const char*)p < buffer + size;
+}
+
+// Definitions in `sysio.cdt/libraries/sysio/arena.hpp`
+SYSIO_TEST_BEGIN(arena_test)
+   //// void* allocate(size_t, size_t)
+   {
+      char buffer[256];
+      arena a(buffer, sizeof(buffer));
+
+      void* p0 = a.allocate(1, 1);
+      void* p1 = a.allocate(8, 8);
+      void* p2 = a.allocate(16, 16);
+      CHECK_EQUAL( in_buffer(p0, buffer, sizeof(buffer)), true )
+      CHECK_EQUAL( in_buffer(p1, buffer, sizeof(buffer)), true )
+      CHECK_EQUAL( in_buffer(p2, buffer, sizeof(buffer)), true )
+      CHECK_EQUAL( (uintptr_t)p1 % 8, 0 )
+      CHECK_EQUAL( (uintptr_t)p2 % 16, 0 )
+      CHECK_EQUAL( a.used(), 25 )
+
+      // requests that do not fit the buffer spill into malloc'd blocks
+      void* p3 = a.allocate(1024, 8);
+      CHECK_EQUAL( in_buffer(p3, buffer, sizeof(buffer)), false )
+      memset(p3, 0xcc, 1024);
+      void* p4 = a.allocate(64 * 1024, 8);
+      CHECK_EQUAL( in_buffer(p4, buffer, sizeof(buffer)), false )
+      memset(p4, 0xdd, 64 * 1024);
+
+      //// void reset()
+      a.reset();
+      CHECK_EQUAL( a.used(), 0 )
+      CHECK_EQUAL( a.allocate(1, 1), (void*)buffer )
+   }
+
+   {
+      arena a(64);
+      char* p0 = (char*)a.allocate(32, 1);
+      char* p1 = (char*)a.allocate(32, 1);
+      char* p2 = (char*)a.allocate(32, 1);
+      memset(p0, 1, 32);
+      memset(p1, 2, 32);
+      memset(p2, 3, 32);
+      CHECK_EQUAL( p0[31] == 1 && p1[0] == 2 && p1[31] == 2 && p2[0] == 3, true )
+      a.reset();
+      CHECK_EQUAL( a.used(), 0 )
+   }
+
+   {
+      // a zero block size falls back to the default one
+      arena a(0);
+      char* p = (char*)a.allocate(100, 1);
+      memset(p, 4, 100);
+      CHECK_EQUAL( p[99], 4 )
+      CHECK_EQUAL( a.used(), 100 )
+   }
+SYSIO_TEST_END
+
+// Definitions in `sysio.cdt/libraries/sysio/arena.hpp`
+SYSIO_TEST_BEGIN(arena_allocator_test)
+   char buffer[1024];
+   arena a(buffer, sizeof(buffer));
+
+   arena_vector<uint64_t> v(a);
+   for( uint64_t i = 0; i < 1000; ++i )
+      v.push_back(i);
+   CHECK_EQUAL( v.size(), 1000 )
+   CHECK_EQUAL( v[0], 0 )
+   CHECK_EQUAL( v[999], 999 )
+   CHECK_EQUAL( v.get_allocator().get_arena(), &a )
+
+   arena_vector<string> s(a);
+   s.emplace_back("abcd");
+   s.emplace_back(100, 'x');
+   CHECK_EQUAL( s[0], "abcd" )
+   CHECK_EQUAL( s[1].size(), 100 )
+SYSIO_TEST_END
+
+// Definitions in `sysio.cdt/libraries/sysio/datastream.hpp`
+SYSIO_TEST_BEGIN(arena_pack_test)
+   char buffer[1024];
+   arena a(buffer, sizeof(buffer));
+
+   //// arena_bytes pack(const T&, arena&)
+   const vector<string> value{ "a", "bc", "def" };
+   arena_bytes packed = pack(value, a);
+   const vector<char> expected = pack(value);
+   CHECK_EQUAL( packed.size(), expected.size() )
+   CHECK_EQUAL( memcmp(packed.data(), expected.data(), expected.size()), 0 )
+   CHECK_EQUAL( in_buffer(packed.data(), buffer, sizeof(buffer)), true )
+
+   //// T unpack(const std::vector<char, Alloc>&)
+   CHECK_EQUAL( unpack<vector<string>>(packed) == value, true )
+
+   //// datastream& operator<<(datastream&, const std::vector<T, Alloc>&)
+   //// datastream& operator>>(datastream&, std::vector<T, Alloc>&)
+   arena_vector<uint32_t> ints(a);
+   ints.push_back(1);
+   ints.push_back(2);
+   ints.push_back(3);
+   CHECK_EQUAL( pack(ints) == pack(vector<uint32_t>{ 1, 2, 3 }), true )
+
+   arena_vector<uint32_t> ints_out(a);
+   const vector<char> ints_packed = pack(ints);
+   datastream<const char*> ds(ints_packed.data(), ints_packed.size());
+   ds >> ints_out;
+   CHECK_EQUAL( ints_out == ints, true )
+SYSIO_TEST_END
+
+int main(int argc, char* argv[]) {
+   bool verbose = false;
+   if( argc >= 2 && std::strcmp( argv[1], "-v" ) == 0 ) {
+      verbose = true;
+   }
+   silence_output(!verbose);
+
+   SYSIO_TEST(arena_test);
+   SYSIO_TEST(arena_allocator_test);
+   SYSIO_TEST(arena_pack_test);
+   return has_failed();
+}
@@ -0,0 +1,230 @@
+/**
+ *  @file
+ *  @copyright defined in sysio.cdt/LICENSE.txt
+ */
+
+#include <string>
+#include <vector>
+
+#include <sysio/sysio.hpp>
+#include <sysio/singleton.hpp>
+#include <sysio/tester.hpp>
+
+using std::string;
+
+using sysio::checksum256;
+using sysio::const_mem_fun;
+using sysio::indexed_by;
+using sysio::multi_index;
+using sysio::name;
+using sysio::singleton;
+using sysio::native::chain_db;
+using sysio::native::intrinsics;
+using namespace sysio::internal_use_do_not_use;
+
+struct record {
+   uint64_t    id;
+   uint64_t    score;
+   double      weight;
+   checksum256 hash;
+   string      memo;
+
+   uint64_t    primary_key() const { return id; }
+   uint64_t    by_score() const { return score; }
+   double      by_weight() const { return weight; }
+   checksum256 by_hash() const { return hash; }
+
+   SYSLIB_SERIALIZE(record, (id)(score)(weight)(hash)(memo))
+};
+
+typedef multi_index<"records"_n, record,
+                    indexed_by<"byscore"_n, const_mem_fun<record, uint64_t, &record::by_score>>,
+                    indexed_by<"byweight"_n, const_mem_fun<record, double, &record::by_weight>>,
+                    indexed_by<"byhash"_n, const_mem_fun<record, checksum256, &record::by_hash>>> records_table;
+
+struct config {
+   uint32_t version;
+   string   owner;
+
+   SYSLIB_SERIALIZE(config, (version)(owner))
+};
+
+typedef singleton<"config"_n, config> config_singleton;
+
+static constexpr name self = "test"_n;
+
+static void setup() {
+   chain_db::install();
+   chain_db::get().clear();
+   chain_db::get().set_receiver( self );
+}
+
+static void emplace_records( records_table& table, uint64_t count ) {
+   for ( uint64_t i = 0; i < count; ++i ) {
+      table.emplace( self, [&]( auto& r ) {
+         r.id     = i;
+         r.score  = count - i;
+         r.weight = i * 0.5;
+         r.hash   = checksum256::make_from_word_sequence<uint64_t>( 0ULL, 0ULL, 0ULL, count - i );
+         r.memo   = std::to_string( i );
+      });
+   }
+}
+
+// Iterator handles returned by the raw intrinsics
+SYSIO_TEST_BEGIN(primary_iterator_test)
+   setup();
+   const uint64_t table = "rows"_n.value;
+
+   CHECK_EQUAL( db_find_i64( self.value, 1, table, 0 ), -1 )
+   CHECK_EQUAL( db_end_i64( self.value, 1, table ), -1 )
+
+   const int32_t first  = db_store_i64( 1, table, self.value, 10, "ab", 2 );
+   const int32_t second = db_store_i64( 1, table, self.value, 20, "cde", 3 );
+   CHECK_EQUAL( first >= 0, true )
+   CHECK_EQUAL( db_find_i64( self.value, 1, table, 10 ), first )
+
+   const int32_t end = db_end_i64( self.value, 1, table );
+   CHECK_EQUAL( end < -1, true )
+   CHECK_EQUAL( db_find_i64( self.value, 1, table, 15 ), end )
+   CHECK_EQUAL( db_lowerbound_i64( self.value, 1, table, 15 ), second )
+   CHECK_EQUAL( db_upperbound_i64( self.value, 1, table, 20 ), end )
+
+   uint64_t primary = 0;
+   CHECK_EQUAL( db_next_i64( first, &primary ), second )
+   CHECK_EQUAL( primary, 20 )
+   CHECK_EQUAL( db_next_i64( second, &primary ), end )
+   CHECK_EQUAL( db_previous_i64( end, &primary ), second )
+   CHECK_EQUAL( db_previous_i64( first, &primary ), -1 )
+
+   char buffer[8] = {};
+   CHECK_EQUAL( db_get_i64( second, buffer, 0 ), 3 )
+   CHECK_EQUAL( db_get_i64( second, buffer, 2 ), 2 )
+   CHECK_EQUAL( string(buffer, 2), "cd" )
+
+   db_update_i64( first, 0, "xyzw", 4 );
+   CHECK_EQUAL( db_get_i64( first, buffer, sizeof(buffer) ), 4 )
+   CHECK_EQUAL( string(buffer, 4), "xyzw" )
+
+   db_remove_i64( first );
+   CHECK_ASSERT( "dereference of deleted object", [&]() { db_get_i64( first, buffer, 0 ); } );
+   db_remove_i64( second );
+   CHECK_EQUAL( db_end_i64( self.value, 1, table ), -1 )
+
+   chain_db::get().set_receiver( "other"_n );
+   const int32_t other = db_store_i64( 1, table, "other"_n.value, 1, "a", 1 );
+   chain_db::get().set_receiver( self );
+   CHECK_ASSERT( "db access violation", [&]() { db_remove_i64( other ); } );
+SYSIO_TEST_END
+
+SYSIO_TEST_BEGIN(multi_index_test)
+   setup();
+   {
+      records_table table( self, self.value );
+      emplace_records( table, 10 );
+      CHECK_EQUAL( table.get( 3 ).memo, "3" )
+      CHECK_ASSERT( "could not insert object, most likely a uniqueness constraint was violated", [&]() {
+         table.emplace( self, [&]( auto& r ) { r.id = 3; } );
+      });
+   }
+
+   // a fresh table object reads everything back from the emulated database
+   records_table table( self, self.value );
+   uint64_t count = 0;
+   for ( const auto& r : table ) {
+      CHECK_EQUAL( r.id, count )
+      ++count;
+   }
+   CHECK_EQUAL( count, 10 )
+
+   auto by_score = table.get_index<"byscore"_n>();
+   uint64_t expected_score = 1;
+   for ( const auto& r : by_score ) {
+      CHECK_EQUAL( r.score, expected_score )
+      ++expected_score;
+   }
+   CHECK_EQUAL( by_score.find( 4 )->id, 6 )
+   CHECK_EQUAL( (--by_score.end())->score, 10 )
+
+   auto by_weight = table.get_index<"byweight"_n>();
+   CHECK_EQUAL( by_weight.lower_bound( 2.2 )->id, 5 )
+   CHECK_EQUAL( by_weight.upper_bound( 2.5 )->id, 6 )
+
+   auto by_hash = table.get_index<"byhash"_n>();
+   CHECK_EQUAL( by_hash.begin()->id, 9 )
+
+   table.modify( table.get( 2 ), self, [&]( auto& r ) { r.score = 100; } );
+   CHECK_EQUAL( (--by_score.end())->id, 2 )
+
+   table.erase( table.get( 9 ) );
+   CHECK_EQUAL( by_score.begin()->id, 8 )
+   CHECK_EQUAL( table.find( 9 ) == table.end(), true )
+
+   auto keys = by_score.range( 3, 6 );
+   uint64_t ids = 0;
+   for ( auto itr = keys.begin(); itr != keys.end(); ++itr )
+      ids = ids * 10 + itr.primary_key();
+   CHECK_EQUAL( ids, 765 )
+
+   CHECK_EQUAL( table.find_view( 4 ).get<&record::memo>(), "4" )
+SYSIO_TEST_END
+
+SYSIO_TEST_BEGIN(deferred_modify_test)
+   setup();
+   // record the payer of each row update on its way to the emulated database
+   std::vector<uint64_t> update_payers;
+   auto update = intrinsics::get_intrinsic<intrinsics::db_update_i64>();
+   intrinsics::set_intrinsic<intrinsics::db_update_i64>([&]( int32_t iterator, capi_name payer, const void* data, uint32_t len ) {
+      update_payers.push_back( payer );
+      update( iterator, payer, data, len );
+   });
+
+   records_table table( self, self.value );
+   emplace_records( table, 3 );
+   table.defer_writes();
+   table.modify( table.get( 1 ), "alice"_n, [&]( auto& r ) { r.score = 100; } );
+   table.modify( table.get( 1 ), sysio::same_payer, [&]( auto& r ) { r.memo = "one"; } );
+   table.modify( table.get( 2 ), sysio::same_payer, [&]( auto& r ) { r.memo = "two"; } );
+   CHECK_EQUAL( update_payers.size(), 0 )
+   table.flush();
+
+   // each row is written once, and a same_payer modification keeps the payer given before it
+   CHECK_EQUAL( update_payers.size(), 2 )
+   CHECK_EQUAL( update_payers[0], "alice"_n.value )
+   CHECK_EQUAL( update_payers[1], sysio::same_payer.value )
+   intrinsics::set_intrinsic<intrinsics::db_update_i64>( update );
+
+   records_table reloaded( self, self.value );
+   CHECK_EQUAL( reloaded.get( 1 ).score, 100 )
+   CHECK_EQUAL( reloaded.get( 1 ).memo, "one" )
+   CHECK_EQUAL( reloaded.get( 2 ).memo, "two" )
+SYSIO_TEST_END
+
+SYSIO_TEST_BEGIN(singleton_test)
+   setup();
+   {
+      config_singleton cfg( self, self.value );
+      CHECK_EQUAL( cfg.exists(), false )
+      cfg.set( config{ 2, "alice" }, self );
+   }
+   config_singleton cfg( self, self.value );
+   CHECK_EQUAL( cfg.exists(), true )
+   CHECK_EQUAL( cfg.get().version, 2 )
+   CHECK_EQUAL( cfg.get().owner, "alice" )
+   cfg.remove();
+   CHECK_EQUAL( cfg.exists(), false )
+SYSIO_TEST_END
+
+int main(int argc, char* argv[]) {
+   bool verbose = false;
+   if( argc >= 2 && std::strcmp( argv[1], "-v" ) == 0 ) {
+      verbose = true;
+   }
+   silence_output(!verbose);
+
+   SYSIO_TEST(primary_iterator_test);
+   SYSIO_TEST(multi_index_test);
+   SYSIO_TEST(deferred_modify_test);
+   SYSIO_TEST(singleton_test);
+   return has_failed();
+}
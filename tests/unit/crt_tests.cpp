@@ -5,6 +5,7 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <string>
 
 #include <sysio/tester.hpp>
@@ -12,6 +13,9 @@
 
 using sysio::cdt::output_stream;
 
+extern "C" size_t _current_memory();
+extern "C" size_t _grow_memory(size_t);
+
 SYSIO_TEST_BEGIN(output_stream_push)
    std_err.clear();
    const char* msg = "abc";
@@ -55,6 +59,67 @@ SYSIO_TEST_BEGIN(output_stream_get_and_push)
    std_err.clear();
 SYSIO_TEST_END
 
+SYSIO_TEST_BEGIN(output_capture)
+   std_out.clear();
+   std_err.clear();
+   _prints_l("abcdef", 3, sysio::cdt::output_stream_kind::std_out);
+   CHECK_EQUAL(std_out.to_string(), "abc");
+
+   // output which is not captured is only written
+   capture_output(false);
+   _prints_l("def", 3, sysio::cdt::output_stream_kind::std_out);
+   _prints("ghi", sysio::cdt::output_stream_kind::std_err);
+   CHECK_EQUAL(std_out.to_string(), "abc");
+   CHECK_EQUAL(std_err.index(), 0);
+
+   // expectations still see the output
+   CHECK_PRINT("jkl", []() { sysio::print("jkl"); });
+   CHECK_ASSERT("mno", []() { sysio::check(false, "mno"); });
+   CHECK_PRINT("-42 42", []() { sysio::print(-42, " ", 42u); });
+   CHECK_EQUAL(___capture_output, false);
+   capture_output(true);
+
+   // buffered output is kept in order across flush policies
+   sysio::cdt::set_flush_policy(sysio::cdt::flush_policy::full);
+   CHECK_PRINT("pqr", []() { sysio::print("p"); sysio::cdt::flush_output(); sysio::print("qr"); });
+   sysio::cdt::set_flush_policy(sysio::cdt::flush_policy::line);
+
+   std_out.clear();
+   std_err.clear();
+SYSIO_TEST_END
+
+SYSIO_TEST_BEGIN(native_heap)
+   // larger than the fixed heap of 100 MiB the native runtime used to have
+   const size_t size = size_t(160) << 20;
+   char* data = static_cast<char*>(malloc(size));
+   REQUIRE_EQUAL(data != nullptr, true);
+   data[0] = 1;
+   data[size - 1] = 2;
+   CHECK_EQUAL(data[0] + data[size - 1], 3);
+   CHECK_EQUAL(sysio::cdt::heap_peak() >= size, true);
+   CHECK_EQUAL(sysio::cdt::heap_peak(), _current_memory() * 64 * 1024);
+   free(data);
+
+   // memory does not grow past the limit, which can be changed within the reserved address space
+   const size_t limit = sysio::cdt::heap_limit();
+   if (std::getenv("SYSIO_NATIVE_HEAP_LIMIT")) {
+      CHECK_EQUAL(limit % (size_t(1) << 20), 0u); // the configured limit, rounded up to the commit step
+   } else {
+      CHECK_EQUAL(limit, size_t(4) << 30);
+   }
+   sysio::cdt::set_heap_limit(sysio::cdt::heap_peak());
+   CHECK_EQUAL(_grow_memory(1), size_t(-1));
+   sysio::cdt::set_heap_limit(limit);
+   const size_t pages = _current_memory();
+   CHECK_EQUAL(_grow_memory(0), pages);
+   CHECK_ASSERT("native heap limit is larger than the reserved address space", []() {
+      sysio::cdt::set_heap_limit(size_t(1) << 50);
+   });
+   CHECK_ASSERT("native heap limit is below the memory in use", []() {
+      sysio::cdt::set_heap_limit(0);
+   });
+SYSIO_TEST_END
+
 int main(int argc, char* argv[]) {
    bool verbose = false;
    if( argc >= 2 && std::strcmp( argv[1], "-v" ) == 0 ) {
@@ -65,5 +130,7 @@ int main(int argc, char* argv[]) {
    SYSIO_TEST(output_stream_push)
    SYSIO_TEST(output_stream_push_overflow)
    SYSIO_TEST(output_stream_get_and_push)
+   SYSIO_TEST(output_capture)
+   SYSIO_TEST(native_heap)
    return has_failed();
 }
@@ -8,10 +8,12 @@
 #include <list>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <sysio/tester.hpp>
 #include <sysio/binary_extension.hpp>
+#include <sysio/bytes_view.hpp>
 #include <sysio/crypto.hpp>
 #include <sysio/datastream.hpp>
 #include <sysio/ignore.hpp>
@@ -28,11 +30,13 @@ using std::optional;
 using std::pair;
 using std::set;
 using std::string;
+using std::string_view;
 using std::tuple;
 using std::variant;
 using std::vector;
 
 using sysio::binary_extension;
+using sysio::bytes_view;
 using sysio::datastream;
 using sysio::fixed_bytes;
 using sysio::ignore;
@@ -45,6 +49,7 @@ using sysio::ecc_signature;
 using sysio::signature;
 using sysio::symbol;
 using sysio::symbol_code;
+using sysio::unchecked_datastream;
 using sysio::unpack;
 
 // This data structure (which cannot be defined within a test macro block) needs both a default and a
@@ -626,6 +631,131 @@ SYSIO_TEST_BEGIN(misc_datastream_test)
    }
 SYSIO_TEST_END
 
+// Definitions in `sysio.cdt/libraries/sysio/datastream.hpp` and `sysio.cdt/libraries/sysio/bytes_view.hpp`
+SYSIO_TEST_BEGIN(borrowed_datastream_test)
+   const string memo{"a memo that is not copied"};
+   const vector<char> blob{'\x00', '\x01', '\x02', '\xff'};
+   const vector<char> packed = pack( std::make_tuple(memo, blob, memo) );
+
+   // borrowed types pack exactly like the owning ones
+   CHECK_EQUAL( pack( string_view{memo} ), pack( memo ) )
+   CHECK_EQUAL( pack( bytes_view{blob} ), pack( blob ) )
+
+   datastream<const char*> ds{packed.data(), packed.size()};
+   string_view memo_view;
+   bytes_view  blob_view;
+   string      memo_copy;
+   ds >> memo_view >> blob_view >> memo_copy;
+   CHECK_EQUAL( ds.remaining(), 0 )
+
+   // the views point into the buffer they were read from
+   CHECK_EQUAL( memo_view, memo )
+   CHECK_EQUAL( memo_view.data(), packed.data() + 1 )
+   CHECK_EQUAL( blob_view == bytes_view{blob}, true )
+   CHECK_EQUAL( blob_view.data(), packed.data() + 1 + memo.size() + 1 )
+   CHECK_EQUAL( blob_view.to_vector(), blob )
+   CHECK_EQUAL( blob_view.subview(1, 2)[1], '\x02' )
+   CHECK_ASSERT( "bytes_view subview out of range", [&]() { blob_view.subview(3, 2); } );
+   CHECK_EQUAL( memo_copy, memo )
+
+   // a size prefix longer than the rest of the buffer is rejected
+   datastream<const char*> truncated{packed.data(), memo.size()};
+   CHECK_ASSERT( "datastream attempted to read past the end", [&]() { truncated >> memo_view; } );
+
+#ifdef __cpp_lib_span
+   datastream<const char*> span_ds{packed.data(), packed.size()};
+   std::span<const char> blob_span;
+   span_ds >> memo_view >> blob_span;
+   CHECK_EQUAL( blob_span.data(), blob_view.data() )
+   CHECK_EQUAL( blob_span.size(), blob.size() )
+   CHECK_EQUAL( pack( blob_span ), pack( blob ) )
+#endif
+SYSIO_TEST_END
+
+// Definitions in `sysio.cdt/libraries/sysio/datastream.hpp`
+SYSIO_TEST_BEGIN(unchecked_datastream_test)
+   const tuple<uint64_t, string, vector<uint32_t>, optional<symbol>> value{
+      42, "unchecked", {1, 2, 3}, symbol{"SYS", 4}
+   };
+   const size_t size = pack_size( value );
+
+   // writes the same bytes as the checked stream
+   vector<char> checked( size );
+   datastream<char*> checked_ds{checked.data(), checked.size()};
+   checked_ds << value;
+
+   vector<char> unchecked( size );
+   unchecked_datastream ds{unchecked.data(), unchecked.size()};
+   ds << value;
+   CHECK_EQUAL( unchecked, checked )
+   CHECK_EQUAL( ds.tellp(), size )
+   CHECK_EQUAL( ds.remaining(), 0 )
+   CHECK_EQUAL( ds.valid(), true )
+   CHECK_EQUAL( ds.pos(), unchecked.data() + size )
+
+   ds.seekp(0);
+   CHECK_EQUAL( ds.put('x'), true )
+   CHECK_EQUAL( ds.write('y'), true )
+   CHECK_EQUAL( ds.tellp(), 2 )
+   CHECK_EQUAL( unchecked[0], 'x' )
+   CHECK_EQUAL( unchecked[1], 'y' )
+   CHECK_EQUAL( ds.seekp(size + 1), false )
+
+   // pack() writes through the unchecked stream
+   CHECK_EQUAL( pack( value ), checked )
+SYSIO_TEST_END
+
+// Definitions in `sysio.cdt/libraries/sysio/datastream.hpp`
+SYSIO_TEST_BEGIN(size_prefix_datastream_test)
+   using sysio::unsigned_int;
+   using sysio::_datastream_detail::min_pack_size;
+
+   static_assert( min_pack_size<uint64_t>() == 8 );
+   static_assert( min_pack_size<string>() == 1 );
+   static_assert( min_pack_size<pair<uint32_t, vector<char>>>() == 5 );
+   static_assert( min_pack_size<optional<uint64_t>>() == 1 );
+   static_assert( min_pack_size<binary_extension<uint64_t>>() == 0 );
+
+   // a size prefix claiming more elements than the bytes left can hold is rejected before anything is allocated
+   const vector<char> huge = pack( unsigned_int(0xffffffff) );
+   const auto rejects = [&]( auto v ) {
+      datastream<const char*> ds{huge.data(), huge.size()};
+      ds >> v;
+   };
+   CHECK_ASSERT( "datastream attempted to read past the end", [&]() { rejects( string{} ); } );
+   CHECK_ASSERT( "datastream attempted to read past the end", [&]() { rejects( vector<uint64_t>{} ); } );
+   CHECK_ASSERT( "datastream attempted to read past the end", [&]() { rejects( vector<string>{} ); } );
+   CHECK_ASSERT( "datastream attempted to read past the end", [&]() { rejects( list<uint32_t>{} ); } );
+   CHECK_ASSERT( "datastream attempted to read past the end", [&]() { rejects( deque<uint32_t>{} ); } );
+   CHECK_ASSERT( "datastream attempted to read past the end", [&]() { rejects( set<uint16_t>{} ); } );
+   CHECK_ASSERT( "datastream attempted to read past the end", [&]() { rejects( map<uint16_t, string>{} ); } );
+
+   // the count is compared against the smallest element, so elements of varying size still unpack
+   const vector<string> strings{"", "a", "a longer string"};
+   CHECK_EQUAL( unpack<vector<string>>( pack( strings ) ), strings )
+   const vector<char> packed_strings = pack( strings );
+   datastream<const char*> short_ds{packed_strings.data(), 3};
+   vector<string> short_strings;
+   CHECK_ASSERT( "datastream attempted to read past the end", [&]() { short_ds >> short_strings; } );
+
+   // elements which may pack to nothing are read one by one
+   const vector<binary_extension<uint64_t>> extensions(3);
+   CHECK_EQUAL( unpack<vector<binary_extension<uint64_t>>>( pack( extensions ) ).size(), 3 )
+
+   // sorted containers are rebuilt in order, and out of order data still unpacks correctly
+   using string_map = map<uint64_t, string>;
+   const string_map sorted{{1, "one"}, {2, "two"}, {3, "three"}};
+   CHECK_EQUAL( unpack<string_map>( pack( sorted ) ), sorted )
+   const set<uint32_t> sorted_set{3, 5, 8};
+   CHECK_EQUAL( unpack<set<uint32_t>>( pack( sorted_set ) ), sorted_set )
+   const vector<uint32_t> unsorted{8, 3, 5};
+   CHECK_EQUAL( unpack<set<uint32_t>>( pack( unsorted ) ), sorted_set )
+   const list<string> strings_list{"x", "yz"};
+   CHECK_EQUAL( unpack<list<string>>( pack( strings_list ) ), strings_list )
+   const deque<uint32_t> numbers{1, 2, 3};
+   CHECK_EQUAL( unpack<deque<uint32_t>>( pack( numbers ) ), numbers )
+SYSIO_TEST_END
+
 int main(int argc, char* argv[]) {
    bool verbose = false;
    if( argc >= 2 && std::strcmp( argv[1], "-v" ) == 0 ) {
@@ -637,5 +767,8 @@ int main(int argc, char* argv[]) {
    SYSIO_TEST(datastream_specialization_test);
    SYSIO_TEST(datastream_stream_test);
    SYSIO_TEST(misc_datastream_test);
+   SYSIO_TEST(borrowed_datastream_test);
+   SYSIO_TEST(unchecked_datastream_test);
+   SYSIO_TEST(size_prefix_datastream_test);
    return has_failed();
 }
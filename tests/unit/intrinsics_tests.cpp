@@ -0,0 +1,173 @@
+/**
+ *  @file
+ *  @copyright defined in sysio.cdt/LICENSE.txt
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <sysio/sysio.hpp>
+#include <sysio/tester.hpp>
+
+using std::string;
+
+using sysio::native::cost_model;
+using sysio::native::execution_cost;
+using sysio::native::intrinsics;
+
+static uint64_t receiver_from_context(void* context) {
+   return *static_cast<uint64_t*>(context);
+}
+
+// the call path of the std::function based table: an out of line call, a function-local static and a type-erased call
+__attribute__((noinline)) static uint64_t std_function_receiver() {
+   static std::function<uint64_t()> func = []() { return "bench"_n.value; };
+   return func();
+}
+
+// Overriding intrinsics through the dispatch table
+SYSIO_TEST_BEGIN(intrinsics_dispatch_test)
+   CHECK_ASSERT( "unsupported intrinsic", []() { current_receiver(); } );
+
+   // lambdas with and without captures
+   intrinsics::set_intrinsic<intrinsics::current_receiver>([]() { return "alice"_n.value; });
+   CHECK_EQUAL( current_receiver(), "alice"_n.value )
+
+   uint64_t calls = 0;
+   intrinsics::set_intrinsic<intrinsics::current_receiver>([&calls]() { ++calls; return "bob"_n.value; });
+   CHECK_EQUAL( current_receiver(), "bob"_n.value )
+   CHECK_EQUAL( current_receiver(), "bob"_n.value )
+   CHECK_EQUAL( calls, 2 )
+
+   // functions with a context pointer get it back on every call
+   uint64_t receiver = "carol"_n.value;
+   intrinsics::set_intrinsic<intrinsics::current_receiver>(&receiver_from_context, &receiver);
+   CHECK_EQUAL( current_receiver(), "carol"_n.value )
+   receiver = "dave"_n.value;
+   CHECK_EQUAL( current_receiver(), "dave"_n.value )
+
+   // a saved slot can be called and put back
+   auto saved = intrinsics::get_intrinsic<intrinsics::current_receiver>();
+   intrinsics::set_intrinsic<intrinsics::current_receiver>([]() { return "erin"_n.value; });
+   CHECK_EQUAL( saved(), "dave"_n.value )
+   intrinsics::set_intrinsic<intrinsics::current_receiver>(saved.func, saved.context);
+   CHECK_EQUAL( current_receiver(), "dave"_n.value )
+
+   // intrinsics returning a different but convertible type still dispatch
+   intrinsics::set_intrinsic<intrinsics::action_data_size>([]() { return 7; });
+   CHECK_EQUAL( action_data_size(), 7 )
+
+   // the copy of a callable is destroyed once the intrinsic is overridden again
+   auto owner = std::make_shared<uint64_t>( "frank"_n.value );
+   intrinsics::set_intrinsic<intrinsics::current_receiver>([owner]() { return *owner; });
+   CHECK_EQUAL( current_receiver(), "frank"_n.value )
+   CHECK_EQUAL( owner.use_count(), 2 )
+   intrinsics::set_intrinsic<intrinsics::current_receiver>([]() { return "gina"_n.value; });
+   CHECK_EQUAL( owner.use_count(), 1 )
+   intrinsics::set_intrinsic<intrinsics::current_receiver>([owner]() { return *owner; });
+   intrinsics::set_intrinsic<intrinsics::current_receiver>(&receiver_from_context, &receiver);
+   CHECK_EQUAL( owner.use_count(), 1 )
+
+   // a saved lambda override stays callable after it is replaced, and is put back with its copy
+   intrinsics::set_intrinsic<intrinsics::current_receiver>([owner]() { return *owner; });
+   auto saved_lambda = intrinsics::get_intrinsic<intrinsics::current_receiver>();
+   intrinsics::set_intrinsic<intrinsics::current_receiver>([]() { return "hank"_n.value; });
+   CHECK_EQUAL( owner.use_count(), 2 )
+   CHECK_EQUAL( saved_lambda(), "frank"_n.value )
+   CHECK_EQUAL( current_receiver(), "hank"_n.value )
+   intrinsics::set_intrinsic<intrinsics::current_receiver>(saved_lambda);
+   CHECK_EQUAL( current_receiver(), "frank"_n.value )
+   saved_lambda = {};
+   CHECK_EQUAL( current_receiver(), "frank"_n.value )
+   CHECK_EQUAL( owner.use_count(), 2 )
+   intrinsics::set_intrinsic<intrinsics::current_receiver>([]() { return "hank"_n.value; });
+   CHECK_EQUAL( owner.use_count(), 1 )
+SYSIO_TEST_END
+
+// Counting host calls and the bytes moved through them
+SYSIO_TEST_BEGIN(cost_model_test)
+   // every test starts from zero
+   CHECK_EQUAL( cost_model::current.host_calls(), 0 )
+
+   intrinsics::set_intrinsic<intrinsics::read_action_data>([](void* msg, uint32_t len) -> uint32_t {
+      memset(msg, 0, std::min(len, 10u));
+      return 10;
+   });
+   intrinsics::set_intrinsic<intrinsics::db_store_i64>(
+         [](uint64_t, capi_name, capi_name, uint64_t, const void*, uint32_t) { return 0; });
+   intrinsics::set_intrinsic<intrinsics::db_get_i64>([](int32_t, const void*, uint32_t len) { return 20; });
+
+   const execution_cost before = cost_model::current;
+   char buffer[16];
+   read_action_data(buffer, 0);
+   read_action_data(buffer, sizeof(buffer));
+   db_store_i64(0, 0, 0, 0, buffer, 12);
+   db_get_i64(0, buffer, 0);
+   db_get_i64(0, buffer, sizeof(buffer));
+   const execution_cost cost = cost_model::current - before;
+
+   CHECK_EQUAL( cost.intrinsic_calls[intrinsics::read_action_data], 2 )
+   CHECK_EQUAL( cost.intrinsic_calls[intrinsics::db_store_i64], 1 )
+   CHECK_EQUAL( cost.intrinsic_calls[intrinsics::db_get_i64], 2 )
+   CHECK_EQUAL( cost.host_calls(), 5 )
+   // only the bytes actually copied are counted
+   CHECK_EQUAL( cost.action_data_bytes, 10 )
+   CHECK_EQUAL( cost.db_read_bytes, 16 )
+   CHECK_EQUAL( cost.db_write_bytes, 12 )
+   CHECK_EQUAL( std::string(cost_model::intrinsic_names[intrinsics::db_get_i64]), "db_get_i64" )
+
+   // the report holds the tests recorded so far
+   const string report = cost_model::to_json();
+   CHECK_EQUAL( report.find("\"name\": \"intrinsics_dispatch_test\"") != string::npos, true )
+   CHECK_EQUAL( report.find("\"current_receiver\": ") != string::npos, true )
+   CHECK_EQUAL( report.find("\"db_get_i64\""), string::npos )
+
+   // a test records how much it grew the heap, not the peak of every test before it
+   const size_t peak_before = sysio::cdt::heap_peak();
+   cost_model::reset();
+   void* block = malloc(1024 * 1024);
+   cost_model::record("heap_growth", true);
+   const size_t heap_bytes = cost_model::tests.back().heap_bytes;
+   cost_model::tests.pop_back();
+   free(block);
+   CHECK_EQUAL( heap_bytes >= 1024 * 1024, true )
+   CHECK_EQUAL( heap_bytes <= sysio::cdt::heap_peak() - peak_before, true )
+SYSIO_TEST_END
+
+// Cost of one intrinsic call through the dispatch table, compared with the std::function based table it replaced.
+// The numbers are printed with -v
+SYSIO_TEST_BEGIN(intrinsics_dispatch_bench)
+   constexpr uint64_t iterations = 1000000;
+
+   intrinsics::set_intrinsic<intrinsics::current_receiver>([]() { return "bench"_n.value; });
+   uint64_t sum   = 0;
+   uint64_t start = __builtin_readcyclecounter();
+   for (uint64_t i = 0; i < iterations; ++i)
+      sum += current_receiver();
+   const uint64_t table_cycles = __builtin_readcyclecounter() - start;
+
+   start = __builtin_readcyclecounter();
+   for (uint64_t i = 0; i < iterations; ++i)
+      sum += std_function_receiver();
+   const uint64_t function_cycles = __builtin_readcyclecounter() - start;
+
+   CHECK_EQUAL( sum, 2 * iterations * "bench"_n.value )
+   sysio::print( "intrinsic call: ", table_cycles / iterations, " cycles through the dispatch table, ",
+                 function_cycles / iterations, " cycles through std::function\n" );
+SYSIO_TEST_END
+
+int main(int argc, char* argv[]) {
+   bool verbose = false;
+   if( argc >= 2 && std::strcmp( argv[1], "-v" ) == 0 ) {
+      verbose = true;
+   }
+   silence_output(!verbose);
+
+   SYSIO_TEST(intrinsics_dispatch_test);
+   SYSIO_TEST(cost_model_test);
+   SYSIO_TEST(intrinsics_dispatch_bench);
+   return has_failed();
+}
@@ -1,7 +1,10 @@
 #include <sysio/sysio.hpp>
+#include <sysio/asset.hpp>
+#include <sysio/crypto.hpp>
 #include <sysio/tester.hpp>
 
 using namespace sysio::native;
+using namespace sysio;
 
 SYSIO_TEST_BEGIN(print_test)
    CHECK_PRINT("27", [](){ sysio::print((uint8_t)27); });
@@ -22,6 +25,41 @@ SYSIO_TEST_BEGIN(print_test)
    CHECK_PRINT("0xffffff9affffffffffffffffffffffff", [](){ sysio::print((int128_t)-102); });
 SYSIO_TEST_END
 
+SYSIO_TEST_BEGIN(print_f_test)
+   const symbol sys{"SYS", 4};
+   const checksum256 hash = checksum256::make_from_word_sequence<uint32_t>(0x01020304u, 0u, 0u, 0u, 0u, 0u, 0u, 0xa0b0c0d0u);
+
+   CHECK_PRINT("a = 1, b = -2", [](){ print_f("a = %, b = %", 1, -2); });
+   CHECK_PRINT("0 18446744073709551615 -9223372036854775808", [](){
+      print_f("% % %", uint64_t(0), std::numeric_limits<uint64_t>::max(), std::numeric_limits<int64_t>::min());
+   });
+   CHECK_PRINT("true false x", [](){ print_f("% % %", true, false, 'x'); });
+   CHECK_PRINT("alice sent 1.0000 SYS in 4,SYS", [&](){ print_f("% sent % in %", "alice"_n, asset{10000, sys}, sys); });
+   CHECK_PRINT("-0.0042 SYS@sysio.token", [&](){ print(extended_asset{asset{-42, sys}, "sysio.token"_n}); });
+   CHECK_PRINT("4,SYS@sysio.token", [&](){ print(extended_symbol{sys, "sysio.token"_n}); });
+   CHECK_PRINT("SYS", [&](){ sys.print(false); });
+   CHECK_PRINT("hash 01020304000000000000000000000000000000000000000000000000a0b0c0d0", [&](){ print_f("hash %", hash); });
+   CHECK_PRINT("str view cstr", [](){ print_f("% % %", std::string("str"), std::string_view("view"), "cstr"); });
+   // missing values leave the rest of the format as it is, and extra values are dropped
+   CHECK_PRINT("1 % 2", [](){ print_f("% % 2", 1); });
+   CHECK_PRINT("1 2", [](){ print_f("% 2", 1, 3); });
+
+   // a formatted message costs a single host call
+   const execution_cost before = cost_model::current;
+   print_f("% sent % to %, memo: %, hash: %", "alice"_n, asset{10000, sys}, "bob"_n, std::string(40, 'm'), hash);
+   print("alice", " ", 42u, " ", sys, " ", true);
+   const execution_cost cost = cost_model::current - before;
+   CHECK_EQUAL( cost.intrinsic_calls[intrinsics::prints_l], 2 )
+   CHECK_EQUAL( cost.host_calls(), 2 )
+
+   // output longer than the buffer is printed in chunks
+   const std::string long_text(600, 'l');
+   CHECK_PRINT([&](std::string s){ return s == long_text + "!" + long_text; },
+               [&](){ print_f("%!%", long_text, long_text); });
+   CHECK_PRINT([](std::string s){ return s == std::string(300, 'a') + "alice"; },
+               [](){ print_f("%%", std::string(300, 'a'), "alice"_n); });
+SYSIO_TEST_END
+
 int main(int argc, char** argv) {
    bool verbose = false;
    if( argc >= 2 && std::strcmp( argv[1], "-v" ) == 0 ) {
@@ -30,5 +68,6 @@ int main(int argc, char** argv) {
    silence_output(!verbose);
 
    SYSIO_TEST(print_test);
+   SYSIO_TEST(print_f_test);
    return has_failed();
 }
@@ -10,7 +10,9 @@
 #include <vector>
 
 #include <sysio/tester.hpp>
+#include <sysio/asset.hpp>
 #include <sysio/datastream.hpp>
+#include <sysio/fixed_bytes.hpp>
 #include <sysio/serialize.hpp>
 
 using std::begin;
@@ -21,7 +23,12 @@ using std::string;
 using std::tie;
 using std::vector;
 
+using sysio::asset;
+using sysio::checksum256;
 using sysio::datastream;
+using sysio::fixed_pack_size_v;
+using sysio::name;
+using sysio::symbol;
 
 struct B {
    const char c{};
@@ -50,6 +57,52 @@ struct D2 : public D1 {
    }
 };
 
+struct fixed_row {
+   name                    owner;
+   asset                   balance;
+   std::array<uint32_t, 3> counters;
+   checksum256             hash;
+   SYSLIB_SERIALIZE( fixed_row, (owner)(balance)(counters)(hash) )
+};
+
+struct fixed_row_ex : public fixed_row {
+   bool flag;
+   SYSLIB_SERIALIZE_DERIVED( fixed_row_ex, fixed_row, (flag) )
+};
+
+struct unserialized_row : public fixed_row {
+   string memo;
+};
+
+struct bitfield_row {
+   uint32_t kind  : 4;
+   uint32_t count : 28;
+   SYSLIB_SERIALIZE( bitfield_row, (kind)(count) )
+};
+
+struct custom_base {
+   uint32_t id;
+   template<typename DataStream>
+   friend DataStream& operator<<( DataStream& ds, const custom_base& b ) { return ds << b.id; }
+   template<typename DataStream>
+   friend DataStream& operator>>( DataStream& ds, custom_base& b ) { return ds >> b.id; }
+};
+
+struct custom_derived : public custom_base {
+   uint8_t flag;
+   SYSLIB_SERIALIZE_DERIVED( custom_derived, custom_base, (flag) )
+};
+
+class private_base {
+   uint32_t id;
+   SYSLIB_SERIALIZE( private_base, (id) )
+};
+
+struct private_derived : public private_base {
+   uint8_t flag;
+   SYSLIB_SERIALIZE_DERIVED( private_derived, private_base, (flag) )
+};
+
 // Definitions in `sysio.cdt/libraries/sysio/serialize.hpp`
 SYSIO_TEST_BEGIN(serialize_test)
    static constexpr uint16_t buffer_size{256};
@@ -101,6 +154,50 @@ SYSIO_TEST_BEGIN(serialize_test)
    REQUIRE_EQUAL( d2, dd2 )
 SYSIO_TEST_END
 
+// Definitions in `sysio.cdt/libraries/sysio/datastream.hpp`
+SYSIO_TEST_BEGIN(fixed_pack_size_test)
+   static_assert( fixed_pack_size_v<B> == 1 );
+   static_assert( fixed_pack_size_v<D1> == 1 + sizeof(int) );
+   static_assert( fixed_pack_size_v<D2> == 0 );
+   static_assert( fixed_pack_size_v<const name> == 8 );
+   static_assert( fixed_pack_size_v<symbol> == 8 );
+   static_assert( fixed_pack_size_v<asset> == 16 );
+   static_assert( fixed_pack_size_v<fixed_row> == 8 + 16 + 12 + 32 );
+   static_assert( fixed_pack_size_v<fixed_row_ex> == fixed_pack_size_v<fixed_row> + 1 );
+   static_assert( fixed_pack_size_v<unserialized_row> == 0 );
+   static_assert( fixed_pack_size_v<string> == 0 );
+   static_assert( fixed_pack_size_v<vector<uint64_t>> == 0 );
+   static_assert( fixed_pack_size_v<std::array<asset, 2>> == 32 );
+   static_assert( fixed_pack_size_v<std::array<string, 2>> == 0 );
+   static_assert( fixed_pack_size_v<bitfield_row> == 0 );
+   static_assert( fixed_pack_size_v<custom_derived> == 0 );
+   static_assert( fixed_pack_size_v<private_derived> == 0 );
+
+   bitfield_row bits{};
+   bits.kind  = 3;
+   bits.count = 1000;
+   CHECK_EQUAL( sysio::pack( bits ).size(), 2 * sizeof(uint32_t) )
+   CHECK_EQUAL( sysio::pack( custom_derived{ { 7 }, 1 } ).size(), sizeof(uint32_t) + 1 )
+
+   const fixed_row_ex row{ { "alice"_n, asset{ 5, symbol{"SYS", 4} }, { 1, 2, 3 },
+                             checksum256::make_from_word_sequence<uint64_t>( 1ULL, 2ULL, 3ULL, 4ULL ) }, true };
+   const vector<char> packed = sysio::pack( row );
+   CHECK_EQUAL( sysio::pack_size( row ), packed.size() )
+   CHECK_EQUAL( packed.size(), fixed_pack_size_v<fixed_row_ex> )
+
+   const fixed_row_ex unpacked = sysio::unpack<fixed_row_ex>( packed );
+   CHECK_EQUAL( unpacked.owner, row.owner )
+   CHECK_EQUAL( unpacked.balance, row.balance )
+   CHECK_EQUAL( unpacked.counters[2], 3 )
+   CHECK_EQUAL( unpacked.hash, row.hash )
+   CHECK_EQUAL( unpacked.flag, true )
+
+   // vectors of fixed size rows are sized without visiting the elements
+   const vector<fixed_row_ex> rows( 3, row );
+   CHECK_EQUAL( sysio::pack_size( rows ), 1 + 3 * fixed_pack_size_v<fixed_row_ex> )
+   CHECK_EQUAL( sysio::pack( rows ).size(), sysio::pack_size( rows ) )
+SYSIO_TEST_END
+
 int main(int argc, char* argv[]) {
    bool verbose = false;
    if( argc >= 2 && std::strcmp( argv[1], "-v" ) == 0 ) {
@@ -109,5 +206,6 @@ int main(int argc, char* argv[]) {
    silence_output(!verbose);
 
    SYSIO_TEST(serialize_test)
+   SYSIO_TEST(fixed_pack_size_test)
    return has_failed();
 }
@@ -0,0 +1,42 @@
+#include <sysio/sysio.hpp>
+
+#include <vector>
+
+using namespace sysio;
+
+// Benchmark contract for the malloc implementations.
+// It is built against the default, the freeing and the size-class allocator so that the cost and
+// the number of memory pages of the same allocation pattern can be compared.
+class [[sysio::contract]] alloc_bench : public contract {
+   public:
+      using contract::contract;
+
+      [[sysio::action]]
+      void allocbench(uint32_t live, uint32_t rounds) {
+         check(live > 0, "live must be positive");
+         std::vector<char*> slots(live, nullptr);
+
+         // replace one live allocation per step with one of a different size, most of them small
+         uint32_t seed = 1;
+         for (uint32_t i = 0; i < rounds * live; ++i) {
+            seed = seed * 1103515245 + 12345;
+            const uint32_t slot = (seed >> 8) % live;
+            const size_t   size = (seed >> 16) % 8 == 0 ? 512 + (seed >> 20) % 4096 : 1 + (seed >> 20) % 256;
+            free(slots[slot]);
+            slots[slot] = (char*)malloc(size);
+            slots[slot][0] = slot;
+            slots[slot][size - 1] = slot;
+         }
+
+         // grow a buffer the way containers do
+         std::vector<uint64_t> grown;
+         for (uint32_t i = 0; i < rounds * live; ++i)
+            grown.push_back(i);
+         check(grown.back() == rounds * live - 1, "wrong value in grown vector");
+
+         for (char* p : slots)
+            free(p);
+
+         print("pages: ", __builtin_wasm_memory_size(0));
+      }
+};
@@ -0,0 +1,64 @@
+#include <sysio/sysio.hpp>
+
+using namespace sysio;
+
+// Benchmark contract for the generated action dispatch.
+// It has enough actions that comparing the action name against each of them in turn
+// shows up in the cost of an action, so the first and the last action can be compared.
+class [[sysio::contract]] dispatch_bench : public contract {
+   public:
+      using contract::contract;
+
+      [[sysio::action]] void da(uint64_t nonce) {}
+      [[sysio::action]] void db(uint64_t nonce) {}
+      [[sysio::action]] void dc(uint64_t nonce) {}
+      [[sysio::action]] void dd(uint64_t nonce) {}
+      [[sysio::action]] void de(uint64_t nonce) {}
+      [[sysio::action]] void df(uint64_t nonce) {}
+      [[sysio::action]] void dg(uint64_t nonce) {}
+      [[sysio::action]] void dh(uint64_t nonce) {}
+      [[sysio::action]] void di(uint64_t nonce) {}
+      [[sysio::action]] void dj(uint64_t nonce) {}
+      [[sysio::action]] void dk(uint64_t nonce) {}
+      [[sysio::action]] void dl(uint64_t nonce) {}
+      [[sysio::action]] void dm(uint64_t nonce) {}
+      [[sysio::action]] void dn(uint64_t nonce) {}
+      [[sysio::action]] void do(uint64_t nonce) {}
+      [[sysio::action]] void dp(uint64_t nonce) {}
+      [[sysio::action]] void dq(uint64_t nonce) {}
+      [[sysio::action]] void dr(uint64_t nonce) {}
+      [[sysio::action]] void ds(uint64_t nonce) {}
+      [[sysio::action]] void dt(uint64_t nonce) {}
+      [[sysio::action]] void du(uint64_t nonce) {}
+      [[sysio::action]] void dv(uint64_t nonce) {}
+      [[sysio::action]] void dw(uint64_t nonce) {}
+      [[sysio::action]] void dx(uint64_t nonce) {}
+      [[sysio::action]] void dy(uint64_t nonce) {}
+      [[sysio::action]] void dz(uint64_t nonce) {}
+      [[sysio::action]] void ea(uint64_t nonce) {}
+      [[sysio::action]] void eb(uint64_t nonce) {}
+      [[sysio::action]] void ec(uint64_t nonce) {}
+      [[sysio::action]] void ed(uint64_t nonce) {}
+      [[sysio::action]] void ee(uint64_t nonce) {}
+      [[sysio::action]] void ef(uint64_t nonce) {}
+      [[sysio::action]] void eg(uint64_t nonce) {}
+      [[sysio::action]] void eh(uint64_t nonce) {}
+      [[sysio::action]] void ei(uint64_t nonce) {}
+      [[sysio::action]] void ej(uint64_t nonce) {}
+      [[sysio::action]] void ek(uint64_t nonce) {}
+      [[sysio::action]] void el(uint64_t nonce) {}
+      [[sysio::action]] void em(uint64_t nonce) {}
+      [[sysio::action]] void en(uint64_t nonce) {}
+      [[sysio::action]] void eo(uint64_t nonce) {}
+      [[sysio::action]] void ep(uint64_t nonce) {}
+      [[sysio::action]] void eq(uint64_t nonce) {}
+      [[sysio::action]] void er(uint64_t nonce) {}
+      [[sysio::action]] void es(uint64_t nonce) {}
+      [[sysio::action]] void et(uint64_t nonce) {}
+      [[sysio::action]] void eu(uint64_t nonce) {}
+      [[sysio::action]] void ev(uint64_t nonce) {}
+      [[sysio::action]] void ew(uint64_t nonce) {}
+      [[sysio::action]] void ex(uint64_t nonce) {}
+      [[sysio::action]] void ey(uint64_t nonce) {}
+      [[sysio::action]] void ez(uint64_t nonce) {}
+};
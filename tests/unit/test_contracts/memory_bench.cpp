@@ -0,0 +1,42 @@
+#include <sysio/sysio.hpp>
+
+#include <cstring>
+
+using namespace sysio;
+
+// Benchmark contract for memcpy, memmove, memset and memcmp.
+// It is built once against the host intrinsics and once with -mbulk-memory so that
+// the cost of the same action can be compared across buffer sizes.
+class [[sysio::contract]] memory_bench : public contract {
+   public:
+      using contract::contract;
+
+      [[sysio::action]]
+      void membench(uint32_t size, uint32_t iterations) {
+         // the extra byte keeps the memmove source and destination overlapping and misaligned
+         char* src = (char*)malloc(size + 1);
+         char* dst = (char*)malloc(size + 1);
+         // a pattern which differs between neighbouring bytes, so that a move off by a byte is caught
+         const auto pattern = [](uint32_t j) { return char(j * 31 + 7); };
+         for (uint32_t j = 0; j <= size; ++j)
+            src[j] = pattern(j);
+
+         int cmp = 0;
+         for (uint32_t i = 0; i < iterations; ++i) {
+            memcpy(dst, src, size);
+            memmove(dst + 1, dst, size);
+            memset(dst, i & 0xff, size);
+            cmp += memcmp(dst, src, size);
+         }
+         check(iterations == 0 || cmp != 0 || size == 0, "memcmp should have found a difference");
+
+         // overlapping moves of the pattern one byte down and back up
+         memcpy(dst, src, size + 1);
+         memmove(dst, dst + 1, size);
+         for (uint32_t j = 0; j < size; ++j)
+            check(dst[j] == pattern(j + 1), "memmove down produced wrong result");
+         memmove(dst + 1, dst, size);
+         for (uint32_t j = 1; j <= size; ++j)
+            check(dst[j] == pattern(j), "memmove up produced wrong result");
+      }
+};
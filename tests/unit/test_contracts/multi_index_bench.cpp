@@ -0,0 +1,274 @@
+#include <sysio/sysio.hpp>
+#include <sysio/asset.hpp>
+#include <sysio/crypto.hpp>
+
+using namespace sysio;
+
+// Benchmark contract for the multi_index row cache.
+// Every action operates on `rows` rows in its own `scope` so that the cost of a
+// single action can be measured as the number of cached rows grows.
+class [[sysio::contract]] multi_index_bench : public contract {
+   public:
+      using contract::contract;
+
+      struct [[sysio::table]] row {
+         uint64_t id;
+         uint64_t value;
+
+         uint64_t primary_key() const { return id; }
+         uint64_t by_value() const { return value; }
+
+         SYSLIB_SERIALIZE(row, (id)(value))
+      };
+
+      struct [[sysio::table]] wide_row {
+         uint64_t                 id;
+         checksum256              hash;
+         std::string              memo;
+         std::vector<uint64_t>    history;
+         uint64_t                 balance;
+
+         uint64_t primary_key() const { return id; }
+
+         SYSLIB_SERIALIZE(wide_row, (id)(hash)(memo)(history)(balance))
+      };
+
+      struct [[sysio::table]] balance_row {
+         uint64_t    id;
+         name        owner;
+         asset       balance;
+         symbol      fee_symbol;
+         checksum256 hash;
+
+         uint64_t primary_key() const { return id; }
+
+         SYSLIB_SERIALIZE(balance_row, (id)(owner)(balance)(fee_symbol)(hash))
+      };
+
+      // the same row with an always empty vector, so that its packed size has to be computed field by field
+      struct [[sysio::table]] dynamic_balance_row {
+         uint64_t             id;
+         name                 owner;
+         asset                balance;
+         symbol               fee_symbol;
+         checksum256          hash;
+         std::vector<uint8_t> extra;
+
+         uint64_t primary_key() const { return id; }
+
+         SYSLIB_SERIALIZE(dynamic_balance_row, (id)(owner)(balance)(fee_symbol)(hash)(extra))
+      };
+
+      typedef multi_index<"rows"_n, row,
+                          indexed_by<"byvalue"_n, const_mem_fun<row, uint64_t, &row::by_value>>> rows_table;
+      typedef multi_index<"widerows"_n, wide_row> wide_rows_table;
+      typedef multi_index<"balances"_n, balance_row> balances_table;
+      typedef multi_index<"dynbalances"_n, dynamic_balance_row> dynamic_balances_table;
+
+      template<typename Table>
+      void emplace_and_modify(uint64_t scope, uint32_t rows, uint32_t repeats) {
+         Table table(get_self(), scope);
+         for (uint32_t i = 0; i < rows; ++i) {
+            table.emplace(get_self(), [&](auto& r) {
+               r.id         = i;
+               r.owner      = name{i + 1};
+               r.balance    = asset{i, symbol{"SYS", 4}};
+               r.fee_symbol = symbol{"FEE", 2};
+               r.hash       = sha256((const char*)&i, sizeof(i));
+            });
+         }
+         for (uint32_t n = 0; n < repeats; ++n) {
+            for (uint32_t i = 0; i < rows; ++i) {
+               table.modify(table.get(i), same_payer, [&](auto& r) {
+                  r.balance.amount += 1;
+               });
+            }
+         }
+         for (uint32_t i = 0; i < rows; ++i) {
+            check(table.get(i).balance.amount == i + repeats, "modified row was not written");
+         }
+      }
+
+      // emplace `rows` rows and then look every one of them up again through the cache
+      [[sysio::action]]
+      void findbench(uint64_t scope, uint32_t rows) {
+         rows_table table(get_self(), scope);
+         for (uint32_t i = 0; i < rows; ++i) {
+            table.emplace(get_self(), [&](auto& r) {
+               r.id    = i;
+               r.value = rows - i;
+            });
+         }
+         for (uint32_t i = 0; i < rows; ++i) {
+            check(table.get(i).value == rows - i, "wrong row found");
+         }
+      }
+
+      // load every row of `scope` into the cache and then erase them all
+      [[sysio::action]]
+      void erasebench(uint64_t scope, uint32_t rows) {
+         rows_table table(get_self(), scope);
+         uint32_t loaded = 0;
+         for (auto itr = table.begin(); itr != table.end(); ++itr)
+            ++loaded;
+         check(loaded == rows, "unexpected number of rows");
+         for (uint32_t i = 0; i < rows; ++i) {
+            table.erase(table.require_find(i, "row to erase not found"));
+         }
+         check(table.begin() == table.end(), "table should be empty");
+      }
+
+      // emplace `rows` rows and modify every one of them `repeats` times, with each change written through
+      // or with the writes deferred to a single flush
+      [[sysio::action]]
+      void modifybench(uint64_t scope, uint32_t rows, uint32_t repeats, bool deferred) {
+         {
+            rows_table table(get_self(), scope);
+            for (uint32_t i = 0; i < rows; ++i) {
+               table.emplace(get_self(), [&](auto& r) {
+                  r.id    = i;
+                  r.value = i;
+               });
+            }
+            table.defer_writes(deferred);
+            for (uint32_t n = 0; n < repeats; ++n) {
+               for (uint32_t i = 0; i < rows; ++i) {
+                  table.modify(table.get(i), same_payer, [&](auto& r) {
+                     r.value += rows;
+                  });
+               }
+            }
+         }
+
+         // a fresh table object only sees what was written to the database
+         rows_table table(get_self(), scope);
+         auto by_value = table.get_index<"byvalue"_n>();
+         for (uint32_t i = 0; i < rows; ++i) {
+            const uint64_t expected = i + uint64_t(repeats) * rows;
+            check(table.get(i).value == expected, "modified row was not written");
+            auto itr = by_value.find(expected);
+            check(itr != by_value.end() && itr->id == i, "secondary key was not updated");
+         }
+      }
+
+      // emplace `rows` wide rows and read the balance of every one back `repeats` times from a fresh table object,
+      // through full row loads or through views that decode only the balance
+      [[sysio::action]]
+      void viewbench(uint64_t scope, uint32_t rows, uint32_t repeats, bool view) {
+         {
+            wide_rows_table table(get_self(), scope);
+            for (uint32_t i = 0; i < rows; ++i) {
+               table.emplace(get_self(), [&](auto& r) {
+                  r.id      = i;
+                  r.hash    = sha256((const char*)&i, sizeof(i));
+                  r.memo    = std::string(200, 'm');
+                  r.history = std::vector<uint64_t>(16, i);
+                  r.balance = i * 3;
+               });
+            }
+         }
+
+         for (uint32_t n = 0; n < repeats; ++n) {
+            wide_rows_table table(get_self(), scope);
+            for (uint32_t i = 0; i < rows; ++i) {
+               const uint64_t balance = view ? table.find_view(i).get<&wide_row::balance>() : table.get(i).balance;
+               check(balance == i * 3, "wrong balance read");
+            }
+         }
+         wide_rows_table table(get_self(), scope);
+         check(!table.find_view(rows), "view of a missing row should be empty");
+      }
+
+      // emplace `rows` rows and sum the primary keys of the middle half of the secondary index from a fresh table
+      // object, through row loading iterators or through key iterators
+      [[sysio::action]]
+      void rangebench(uint64_t scope, uint32_t rows, bool keys_only) {
+         {
+            rows_table table(get_self(), scope);
+            for (uint32_t i = 0; i < rows; ++i) {
+               table.emplace(get_self(), [&](auto& r) {
+                  r.id    = i;
+                  r.value = rows - i;
+               });
+            }
+         }
+
+         rows_table table(get_self(), scope);
+         auto by_value = table.get_index<"byvalue"_n>();
+         const uint64_t lower = rows / 4, upper = rows - rows / 4;
+         uint64_t sum = 0, count = 0;
+         if (keys_only) {
+            auto keys = by_value.range(lower, upper);
+            for (auto itr = keys.begin(); itr != keys.end(); ++itr, ++count)
+               sum += itr.primary_key();
+            check(keys.begin() == keys.end() || keys.begin().secondary_key() == lower, "wrong first key in range");
+         } else {
+            for (auto itr = by_value.lower_bound(lower); itr != by_value.end() && itr->value < upper; ++itr, ++count)
+               sum += itr->id;
+         }
+
+         uint64_t expected = 0;
+         for (uint64_t value = lower; value < upper; ++value)
+            expected += rows - value;
+         check(count == upper - lower && sum == expected, "wrong rows in range");
+      }
+
+      // emplace `rows` fixed layout rows and modify every one of them `repeats` times, with rows whose packed size is
+      // a compile time constant or with the same rows plus an empty vector
+      [[sysio::action]]
+      void fixedbench(uint64_t scope, uint32_t rows, uint32_t repeats, bool fixed) {
+         static_assert(fixed_pack_size_v<balance_row> > 0 && fixed_pack_size_v<dynamic_balance_row> == 0);
+         if (fixed)
+            emplace_and_modify<balances_table>(scope, rows, repeats);
+         else
+            emplace_and_modify<dynamic_balances_table>(scope, rows, repeats);
+      }
+
+      // emplace the rows `first` to `first + count` of `scope`, so that large tables can be filled over several
+      // transactions
+      [[sysio::action]]
+      void populate(uint64_t scope, uint32_t first, uint32_t count) {
+         rows_table table(get_self(), scope);
+         for (uint32_t i = first; i < first + count; ++i) {
+            table.emplace(get_self(), [&](auto& r) {
+               r.id    = i;
+               r.value = i;
+            });
+         }
+      }
+
+      // load every row of `scope` into the cache of a fresh table object and print the pages of linear memory it
+      // took to hold them
+      [[sysio::action]]
+      void walkbench(uint64_t scope, uint32_t rows) {
+         const size_t pages = __builtin_wasm_memory_size(0);
+         rows_table table(get_self(), scope);
+         uint64_t sum = 0, count = 0;
+         for (auto itr = table.begin(); itr != table.end(); ++itr, ++count)
+            sum += itr->value;
+         check(count == rows && sum == uint64_t(rows) * (rows - 1) / 2, "wrong rows walked");
+         print("pages: ", __builtin_wasm_memory_size(0) - pages);
+      }
+
+      // serialize a wide row `repeats` times into a buffer of its packed size, through a checked datastream or through
+      // the unchecked one the library uses once the size is known
+      [[sysio::action]]
+      void packbench(uint32_t repeats, bool checked) {
+         wide_row r{7, sha256("wide", 4), std::string(200, 'm'), std::vector<uint64_t>(16, 7), 21};
+         std::vector<char> buffer(pack_size(r));
+         uint64_t sum = 0;
+         for (uint32_t n = 0; n < repeats; ++n) {
+            r.balance = n;
+            if (checked) {
+               datastream<char*> ds(buffer.data(), buffer.size());
+               ds << r;
+            } else {
+               unchecked_datastream ds(buffer.data(), buffer.size());
+               ds << r;
+            }
+            sum += buffer.back();
+         }
+         check(unpack<wide_row>(buffer).balance == repeats - 1 || repeats == 0, "wrong row packed");
+         print("checksum: ", sum);
+      }
+};
@@ -4,12 +4,14 @@
  */
 
 #include <limits>
+#include <vector>
 
 #include <sysio/tester.hpp>
 #include <sysio/datastream.hpp>
 #include <sysio/varint.hpp>
 
 using std::numeric_limits;
+using std::vector;
 
 using sysio::datastream;
 using sysio::unsigned_int;
@@ -460,6 +462,161 @@ SYSIO_TEST_BEGIN(signed_int_constexpr_test)
    static_assert( sizeof(signed_int{0xf}) == 4 );
 SYSIO_TEST_END
 
+// The byte at a time encoding which the codec in `sysio.cdt/libraries/sysio/varint.hpp` has to match
+static vector<char> reference_varuint32( uint32_t val ) {
+   vector<char> bytes;
+   do {
+      uint8_t b = uint8_t(val) & 0x7f;
+      val >>= 7;
+      b |= ((val > 0) << 7);
+      bytes.push_back(char(b));
+   } while( val );
+   return bytes;
+}
+
+// Defined in `sysio.cdt/libraries/sysio/varint.hpp`
+SYSIO_TEST_BEGIN(varint_codec_test)
+   static constexpr uint32_t boundaries[] = {
+      0, 1, 0x7f, 0x80, 0x3fff, 0x4000, 0x1fffff, 0x200000, 0xfffffff, 0x10000000, u32max
+   };
+   char buffer[16];
+
+   for( uint32_t v : boundaries ) {
+      const vector<char> expected = reference_varuint32( v );
+      CHECK_EQUAL( sysio::_varint_detail::varuint32_size( v ), expected.size() )
+
+      datastream<char*> ds{buffer, sizeof(buffer)};
+      ds << unsigned_int{v};
+      CHECK_EQUAL( ds.tellp(), expected.size() )
+      CHECK_EQUAL( vector<char>(buffer, buffer + ds.tellp()), expected )
+
+      // decoded from a buffer with and without room for the two byte fast path
+      unsigned_int out{};
+      datastream<const char*> in{buffer, sizeof(buffer)};
+      in >> out;
+      CHECK_EQUAL( out.value, v )
+      CHECK_EQUAL( in.tellp(), expected.size() )
+      datastream<const char*> exact{buffer, expected.size()};
+      exact >> out;
+      CHECK_EQUAL( out.value, v )
+      CHECK_EQUAL( exact.remaining(), 0 )
+   }
+
+   for( int32_t v : { 0, 1, -1, 63, -64, 64, -65, 8191, -8192, i32max, i32min } ) {
+      datastream<char*> ds{buffer, sizeof(buffer)};
+      ds << signed_int{v};
+      CHECK_EQUAL( vector<char>(buffer, buffer + ds.tellp()), reference_varuint32( (uint32_t(v) << 1) ^ uint32_t(v >> 31) ) )
+
+      signed_int out{};
+      datastream<const char*> in{buffer, ds.tellp()};
+      in >> out;
+      CHECK_EQUAL( out.value, v )
+   }
+
+   // a truncated encoding reads past the end
+   const char truncated[] = { char(0x80), char(0x80) };
+   CHECK_ASSERT( "get", [&]() {
+      unsigned_int out{};
+      datastream<const char*> in{truncated, sizeof(truncated)};
+      in >> out;
+   });
+
+   // encodings of more than 5 bytes or more than 32 bits are rejected
+   const char too_long[] = { char(0x80), char(0x80), char(0x80), char(0x80), char(0x80), char(0x00) };
+   CHECK_ASSERT( "varint is longer than 5 bytes", [&]() {
+      unsigned_int out{};
+      datastream<const char*> in{too_long, sizeof(too_long)};
+      in >> out;
+   });
+   const char too_large[] = { char(0xff), char(0xff), char(0xff), char(0xff), char(0x1f) };
+   CHECK_ASSERT( "varint is larger than 32 bits", [&]() {
+      signed_int out{};
+      datastream<const char*> in{too_large, sizeof(too_large)};
+      in >> out;
+   });
+SYSIO_TEST_END
+
+// Defined in `sysio.cdt/libraries/sysio/varint.hpp`
+SYSIO_TEST_BEGIN(varint_stream_round_trip_test)
+   // encode and decode a run of values of every length back to back, as in a stream of size prefixes
+   static constexpr uint32_t count = 100000;
+   vector<uint32_t> values(count);
+   size_t expected_size = 0;
+   for( uint32_t i = 0; i < count; ++i ) {
+      values[i] = (i * 2654435761u) >> (i % 32);
+      expected_size += reference_varuint32( values[i] ).size();
+   }
+
+   vector<char> buffer(count * 5);
+   datastream<char*> ds{buffer.data(), buffer.size()};
+   for( uint32_t v : values )
+      ds << unsigned_int{v};
+   CHECK_EQUAL( ds.tellp(), expected_size )
+
+   datastream<const char*> in{buffer.data(), ds.tellp()};
+   uint32_t mismatches = 0;
+   for( uint32_t v : values ) {
+      unsigned_int out{};
+      in >> out;
+      mismatches += out.value != v;
+   }
+   CHECK_EQUAL( mismatches, 0 )
+   CHECK_EQUAL( in.remaining(), 0 )
+SYSIO_TEST_END
+
+// Defined in `sysio.cdt/libraries/sysio/varint.hpp`
+SYSIO_TEST_BEGIN(varint_codec_bench)
+   static constexpr uint32_t count = 100000;
+   vector<uint32_t> values(count);
+   for( uint32_t i = 0; i < count; ++i )
+      values[i] = (i * 2654435761u) >> (i % 32);
+   vector<char> buffer(count * 5);
+
+   // the codec
+   uint64_t start = __builtin_readcyclecounter();
+   datastream<char*> ds{buffer.data(), buffer.size()};
+   for( uint32_t v : values )
+      ds << unsigned_int{v};
+   datastream<const char*> in{buffer.data(), ds.tellp()};
+   uint64_t sum = 0;
+   for( uint32_t i = 0; i < count; ++i ) {
+      unsigned_int out{};
+      in >> out;
+      sum += out.value;
+   }
+   const uint64_t codec_cycles = __builtin_readcyclecounter() - start;
+
+   // a byte at a time through the stream
+   start = __builtin_readcyclecounter();
+   datastream<char*> byte_ds{buffer.data(), buffer.size()};
+   for( uint32_t v : values ) {
+      do {
+         uint8_t b = uint8_t(v) & 0x7f;
+         v >>= 7;
+         b |= ((v > 0) << 7);
+         byte_ds.put(char(b));
+      } while( v );
+   }
+   datastream<const char*> byte_in{buffer.data(), byte_ds.tellp()};
+   for( uint32_t i = 0; i < count; ++i ) {
+      uint32_t v = 0;
+      char b = 0;
+      uint8_t by = 0;
+      do {
+         byte_in.get(b);
+         v |= uint32_t(uint8_t(b) & 0x7f) << by;
+         by += 7;
+      } while( uint8_t(b) & 0x80 );
+      sum -= v;
+   }
+   const uint64_t byte_cycles = __builtin_readcyclecounter() - start;
+
+   CHECK_EQUAL( sum, 0 )
+   CHECK_EQUAL( byte_ds.tellp(), ds.tellp() )
+   sysio::print( "varint round trip: ", codec_cycles / count, " cycles through the codec, ",
+                 byte_cycles / count, " cycles a byte at a time\n" );
+SYSIO_TEST_END
+
 int main(int argc, char* argv[]) {
    bool verbose = false;
    if( argc >= 2 && std::strcmp( argv[1], "-v" ) == 0 ) {
@@ -471,5 +628,8 @@ int main(int argc, char* argv[]) {
    SYSIO_TEST(signed_int_type_test);
    SYSIO_TEST(unsigned_int_constexpr_test);
    SYSIO_TEST(signed_int_constexpr_test);
+   SYSIO_TEST(varint_codec_test);
+   SYSIO_TEST(varint_stream_round_trip_test);
+   SYSIO_TEST(varint_codec_bench);
    return has_failed();
 }
@@ -0,0 +1,213 @@
+#pragma once
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/Object/Archive.h"
+#include "llvm/Object/Binary.h"
+#include "llvm/Object/SymbolicFile.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <sysio/utils.hpp>
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace sysio { namespace cdt {
+   /**
+    * Merges the action and notify dispatchers of every object of a link into a single apply, which finds the
+    * dispatchers of a name through a binary search instead of comparing the name with each of them in turn.
+    *
+    * Codegen marks each dispatcher with a weak symbol, see `marker`, so that the dispatchers of a link are known from
+    * the symbol tables of its inputs. The marker is never referenced and is dropped by the linker.
+    */
+   class apply_generator {
+      public:
+         /**
+          * The name of the symbol which marks a dispatcher
+          *
+          * @param code - "a" for an action of the receiver, "w" for a notification from any code, or the name value of
+          *               the code a notification is from
+          * @param action - The name value of the action
+          * @param dispatcher - The name of the dispatcher function
+          */
+         static std::string marker(const std::string& code, uint64_t action, const std::string& dispatcher) {
+            return marker_prefix + code + "_" + std::to_string(action) + "_" + dispatcher;
+         }
+
+         /**
+          * Adds the dispatchers marked in an object file, or notes that an archive holds dispatchers
+          *
+          * @return false if the file cannot be read
+          */
+         bool add_file(const std::string& path) {
+            auto buffer = llvm::MemoryBuffer::getFile(path);
+            if (!buffer)
+               return false;
+            auto binary = llvm::object::createBinary((*buffer)->getMemBufferRef(), &context);
+            if (!binary) {
+               llvm::consumeError(binary.takeError());
+               return false;
+            }
+            if (auto* archive = llvm::dyn_cast<llvm::object::Archive>(binary->get())) {
+               // the symbol table of the archive is enough, the members are not parsed
+               for (const auto& sym : archive->symbols()) {
+                  if (sym.getName().startswith(marker_prefix))
+                     archive_dispatchers = true;
+               }
+            } else if (auto* file = llvm::dyn_cast<llvm::object::SymbolicFile>(binary->get())) {
+               for (const auto& sym : file->symbols()) {
+                  std::string name;
+                  llvm::raw_string_ostream os(name);
+                  if (auto err = sym.printName(os)) {
+                     llvm::consumeError(std::move(err));
+                     continue;
+                  }
+                  os.flush();
+                  if (name == "apply")
+                     apply_found = true;
+                  else if (name == "pre_dispatch")
+                     pre_dispatch_found = true;
+                  else if (name == "post_dispatch")
+                     post_dispatch_found = true;
+                  else
+                     add_marker(name);
+               }
+            }
+            return true;
+         }
+
+         /**
+          * Whether apply has to be generated, which is when there are dispatchers and none of the inputs defines apply
+          */
+         bool needed()const {
+            return !apply_found && !(action_dispatchers.empty() && notify_dispatchers.empty() && wildcard_dispatchers.empty());
+         }
+
+         /**
+          * Whether an archive holds dispatchers. They are only linked when something else pulls in their member, which
+          * the symbol tables do not tell, so apply is then left to the linker.
+          */
+         bool dispatchers_in_archive()const { return archive_dispatchers; }
+
+         /**
+          * The C source of apply
+          */
+         std::string source() {
+            ss.str("");
+            ss << "__attribute__((sysio_wasm_import))\n";
+            ss << "void sysio_assert_code(unsigned int, unsigned long long);\n";
+            for (const auto& d : dispatchers)
+               ss << "void " << d << "(unsigned long long, unsigned long long);\n";
+            if (pre_dispatch_found)
+               ss << "_Bool pre_dispatch(unsigned long long, unsigned long long, unsigned long long);\n";
+            if (post_dispatch_found)
+               ss << "void post_dispatch(unsigned long long, unsigned long long, unsigned long long);\n";
+
+            ss << "__attribute__((sysio_wasm_entry))\n";
+            ss << "void apply(unsigned long long r, unsigned long long c, unsigned long long a) {\n";
+            if (pre_dispatch_found)
+               ss << "if (!pre_dispatch(r, c, a)) return;\n";
+            ss << "if (c == r) {\n";
+            emit_action_search(action_dispatchers);
+            if (post_dispatch_found)
+               ss << "post_dispatch(r, c, a);\n";
+            // unknown actions are only allowed on the system account, which receives onerror
+            ss << "if (r != " << string_to_name("sysio") << "ULL) sysio_assert_code(0, 8000000000000000000ULL);\n";
+            ss << "return;\n";
+            ss << "}\n";
+
+            // handlers of a specific code take precedence over the wildcard handlers
+            emit_map_search("c", notify_dispatchers, [&](const auto& d) { emit_action_search(d); });
+            emit_action_search(wildcard_dispatchers);
+            ss << "}\n";
+            return ss.str();
+         }
+
+      private:
+         using dispatcher_map_t = std::map<uint64_t, std::set<std::string>>;
+
+         static constexpr const char* marker_prefix = "__sysio_dispatch_";
+
+         bool add_marker(llvm::StringRef name) {
+            if (!name.consume_front(marker_prefix))
+               return false;
+            const auto code       = name.take_until([](char c) { return c == '_'; });
+            name                  = name.drop_front(std::min(name.size(), code.size() + 1));
+            const auto action_str = name.take_until([](char c) { return c == '_'; });
+            const auto dispatcher = name.drop_front(std::min(name.size(), action_str.size() + 1));
+            uint64_t action = 0;
+            if (code.empty() || dispatcher.empty() || action_str.getAsInteger(10, action))
+               return false;
+            dispatcher_map_t* dispatchers_of_code = nullptr;
+            uint64_t code_value = 0;
+            if (code == "a")
+               dispatchers_of_code = &action_dispatchers;
+            else if (code == "w")
+               dispatchers_of_code = &wildcard_dispatchers;
+            else if (!code.getAsInteger(10, code_value))
+               dispatchers_of_code = &notify_dispatchers[code_value];
+            else
+               return false;
+            (*dispatchers_of_code)[action].insert(dispatcher.str());
+            dispatchers.insert(dispatcher.str());
+            return true;
+         }
+
+         /**
+          * Emits a binary search for `var` over the sorted `keys`, calling `emit_match` with the index of the key in
+          * the branch where it is found. Falls through when `var` is none of the keys.
+          */
+         template <typename F>
+         void emit_name_search(const std::string& var, const std::vector<uint64_t>& keys, size_t lo, size_t hi, F&& emit_match) {
+            // a few comparisons for equality are cheaper than splitting further
+            constexpr size_t max_linear = 4;
+            if (hi - lo <= max_linear) {
+               for (size_t i = lo; i < hi; ++i) {
+                  ss << "if (" << var << " == " << keys[i] << "ULL) {\n";
+                  emit_match(i);
+                  ss << "}\n";
+               }
+               return;
+            }
+            const size_t mid = lo + (hi - lo) / 2;
+            ss << "if (" << var << " < " << keys[mid] << "ULL) {\n";
+            emit_name_search(var, keys, lo, mid, emit_match);
+            ss << "} else {\n";
+            emit_name_search(var, keys, mid, hi, emit_match);
+            ss << "}\n";
+         }
+
+         template <typename T, typename F>
+         void emit_map_search(const std::string& var, const std::map<uint64_t, T>& m, F&& emit_match) {
+            std::vector<uint64_t> keys;
+            for (const auto& e : m)
+               keys.push_back(e.first);
+            emit_name_search(var, keys, 0, keys.size(), [&](size_t i) { emit_match(m.at(keys[i])); });
+         }
+
+         void emit_action_search(const dispatcher_map_t& dispatchers_of_action) {
+            emit_map_search("a", dispatchers_of_action, [&](const auto& d) {
+               for (const auto& dispatcher : d)
+                  ss << dispatcher << "(r, c);\n";
+               ss << "return;\n";
+            });
+         }
+
+         llvm::LLVMContext                    context;
+         std::stringstream                    ss;
+         std::set<std::string>                dispatchers;
+         dispatcher_map_t                     action_dispatchers;
+         std::map<uint64_t, dispatcher_map_t> notify_dispatchers;
+         dispatcher_map_t                     wildcard_dispatchers;
+         bool                                 apply_found         = false;
+         bool                                 pre_dispatch_found  = false;
+         bool                                 post_dispatch_found = false;
+         bool                                 archive_dispatchers = false;
+   };
+}} // ns sysio::cdt
@@ -19,6 +19,7 @@
 #include <sysio/gen.hpp>
 
 #include <sysio/utils.hpp>
+#include <sysio/apply_generator.hpp>
 #include <sysio/whereami/whereami.hpp>
 #include <sysio/abi.hpp>
 #include <sysio/ppcallbacks.hpp>
@@ -146,7 +147,7 @@ namespace sysio { namespace cdt {
          }
 
          template <typename F>
-         void create_dispatch(const std::string& attr, const std::string& func_name, F&& get_str, CXXMethodDecl* decl) {
+         bool create_dispatch(const std::string& attr, const std::string& func_name, F&& get_str, CXXMethodDecl* decl) {
             constexpr static uint32_t max_stack_size = 512;
             codegen& cg = codegen::get();
             std::string nm = decl->getNameAsString()+"_"+decl->getParent()->getNameAsString();
@@ -168,6 +169,8 @@ namespace sysio { namespace cdt {
                ss << ":";
                ss << func_name << nm;
                ss << "\"))) void " << func_name << nm << "(unsigned long long r, unsigned long long c) {\n";
+               // borrowed arguments (std::string_view, std::span<const char>, sysio::bytes_view) point into the
+               // action data buffer, which has to stay alive until the action returns
                ss << "size_t as = ::action_data_size();\n";
                ss << "void* buff = nullptr;\n";
                ss << "if (as > 0) {\n";
@@ -207,18 +210,37 @@ namespace sysio { namespace cdt {
                   ss << "set_action_return_value((void*)packed_result.data(), packed_result.size());\n";
                }
                ss << "}}\n";
-
+               return true;
             }
+            return false;
+         }
+
+         /**
+          * Emits the weak symbol which tells cdt-ld to call the dispatcher from apply for `action` from `code`
+          */
+         void create_dispatch_marker(const std::string& code, const std::string& action, const std::string& dispatcher) {
+            ss << "extern \"C\" {\n";
+            ss << "__attribute__((weak)) char " << apply_generator::marker(code, string_to_name(action.c_str()), dispatcher) << " = 0;\n";
+            ss << "}\n";
          }
 
          void create_action_dispatch(CXXMethodDecl* decl) {
             auto func = [](CXXMethodDecl* d) { return generation_utils::get_action_name(d); };
-            create_dispatch("sysio_wasm_action", "__sysio_action_", func, decl);
+            if (create_dispatch("sysio_wasm_action", "__sysio_action_", func, decl)) {
+               const std::string nm = decl->getNameAsString()+"_"+decl->getParent()->getNameAsString();
+               create_dispatch_marker("a", func(decl), "__sysio_action_"+nm);
+            }
          }
 
          void create_notify_dispatch(CXXMethodDecl* decl) {
             auto func = [](CXXMethodDecl* d) { return generation_utils::get_notify_pair(d); };
-            create_dispatch("sysio_wasm_notify", "__sysio_notify_", func, decl);
+            if (create_dispatch("sysio_wasm_notify", "__sysio_notify_", func, decl)) {
+               const std::string nm   = decl->getNameAsString()+"_"+decl->getParent()->getNameAsString();
+               const std::string pair = func(decl);
+               const std::string code = pair.substr(0, pair.find("::"));
+               const std::string act  = pair.substr(pair.find("::")+2);
+               create_dispatch_marker(code == "*" ? "w" : std::to_string(string_to_name(code.c_str())), act, "__sysio_notify_"+nm);
+            }
          }
 
          virtual bool VisitCXXMethodDecl(CXXMethodDecl* decl) {
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <utime.h>
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace sysio { namespace cdt {
+   /**
+    * Content addressed cache of compiler outputs.
+    *
+    * An entry is a file in the cache directory named after the SHA-1 of everything that went into producing it and
+    * the kind of output it holds. Entries which were not used recently are removed once the directory grows over its
+    * size limit. Hits and misses are counted by appending one byte to the `hits` and `misses` files, which is safe
+    * with several compilers sharing the directory.
+    */
+   class compile_cache {
+      public:
+         /**
+          * Accumulates the inputs of a compile into a cache key
+          */
+         class key {
+            public:
+               key& add(llvm::StringRef data) {
+                  // length prefixed, so that the boundaries between inputs are part of the key
+                  const std::string size = std::to_string(data.size()) + ":";
+                  sha.update(size);
+                  sha.update(data);
+                  return *this;
+               }
+
+               key& add(const std::vector<std::string>& options) {
+                  add(std::to_string(options.size()));
+                  for (const auto& opt : options)
+                     add(opt);
+                  return *this;
+               }
+
+               /**
+                * Adds the contents of a file, or a marker if the file cannot be read
+                */
+               key& add_file(const std::string& path) {
+                  if (auto buffer = llvm::MemoryBuffer::getFile(path))
+                     return add((*buffer)->getBuffer());
+                  return add("<missing " + path + ">");
+               }
+
+               std::string str() {
+                  return llvm::toHex(sha.final(), true);
+               }
+
+            private:
+               llvm::SHA1 sha;
+         };
+
+         compile_cache() = default;
+         compile_cache(std::string dir, uint64_t max_size) : dir(std::move(dir)), max_size(max_size) {
+            if (!this->dir.empty() && llvm::sys::fs::create_directories(this->dir))
+               this->dir.clear();
+         }
+
+         bool enabled()const { return !dir.empty(); }
+
+         using outputs = std::vector<std::pair<std::string, std::string>>;
+
+         /**
+          * Whether the cache holds an entry of the given kind for `k`, without counting a hit or a miss
+          */
+         bool contains(const std::string& k, const std::string& kind)const {
+            return enabled() && llvm::sys::fs::exists(entry_path(k, kind));
+         }
+
+         /**
+          * Copies the entries for `k` to the files they were stored from. The first output is required and the others
+          * are restored when they were stored.
+          *
+          * @param k - The key
+          * @param files - Pairs of the kind of output, e.g. "o" or "abi", and the file to restore it to
+          * @return true on a hit
+          */
+         bool restore(const std::string& k, const outputs& files) {
+            if (!enabled())
+               return false;
+            if (files.empty() || !llvm::sys::fs::exists(entry_path(k, files.front().first))) {
+               count("misses");
+               return false;
+            }
+            for (const auto& f : files) {
+               const std::string entry = entry_path(k, f.first);
+               if (!llvm::sys::fs::exists(entry))
+                  continue;
+               if (llvm::sys::fs::copy_file(entry, f.second)) {
+                  count("misses");
+                  return false;
+               }
+               // the modification time of an entry is its last use
+               utime(entry.c_str(), nullptr);
+            }
+            count("hits");
+            return true;
+         }
+
+         /**
+          * Copies the files which exist into the cache as the entries for `k`, then trims the cache to its size limit
+          *
+          * @param k - The key
+          * @param files - Pairs of the kind of output and the file holding it
+          */
+         void store(const std::string& k, const outputs& files) {
+            if (!enabled())
+               return;
+            for (const auto& f : files) {
+               if (!llvm::sys::fs::exists(f.second))
+                  continue;
+               // written next to the entry and renamed, so that readers never see a partial entry
+               const std::string entry = entry_path(k, f.first);
+               llvm::SmallString<128> tmp;
+               if (llvm::sys::fs::createUniqueFile(entry + ".tmp-%%%%%%", tmp))
+                  return;
+               if (llvm::sys::fs::copy_file(f.second, tmp) || llvm::sys::fs::rename(tmp, entry)) {
+                  llvm::sys::fs::remove(tmp);
+                  return;
+               }
+            }
+            trim();
+         }
+
+         /**
+          * Removes the least recently used entries until the cache fits in its size limit
+          */
+         void trim() {
+            std::vector<std::tuple<llvm::sys::TimePoint<>, uint64_t, std::string>> entries;
+            uint64_t total = 0;
+            std::error_code ec;
+            for (llvm::sys::fs::directory_iterator it(dir, ec), end; it != end && !ec; it.increment(ec)) {
+               const std::string path = it->path();
+               const auto name = llvm::sys::path::filename(path);
+               if (name == "hits" || name == "misses")
+                  continue;
+               llvm::sys::fs::file_status status;
+               if (llvm::sys::fs::status(path, status) || !llvm::sys::fs::is_regular_file(status))
+                  continue;
+               entries.emplace_back(status.getLastModificationTime(), status.getSize(), path);
+               total += status.getSize();
+            }
+            std::sort(entries.begin(), entries.end());
+            for (const auto& e : entries) {
+               if (total <= max_size)
+                  break;
+               if (!llvm::sys::fs::remove(std::get<2>(e)))
+                  total -= std::get<1>(e);
+            }
+         }
+
+         /**
+          * Prints the hits and misses of this compiler run and of every run sharing the cache directory
+          */
+         void print_stats(llvm::raw_ostream& os, llvm::StringRef tool)const {
+            const uint64_t total_hits = counter("hits"), total_misses = counter("misses");
+            os << tool << " cache: " << hits << " hits, " << misses << " misses"
+               << " (" << total_hits << " hits, " << total_misses << " misses in " << dir << ")\n";
+         }
+
+      private:
+         std::string entry_path(const std::string& k, const std::string& kind)const {
+            return dir + "/" + k + "." + kind;
+         }
+
+         void count(const std::string& counter_name) {
+            (counter_name == "hits" ? hits : misses)++;
+            std::ofstream(dir + "/" + counter_name, std::ios::app | std::ios::binary).put('+');
+         }
+
+         uint64_t counter(const std::string& counter_name)const {
+            uint64_t size = 0;
+            if (llvm::sys::fs::file_size(dir + "/" + counter_name, size))
+               return 0;
+            return size;
+         }
+
+         std::string dir;
+         uint64_t    max_size = 0;
+         uint64_t    hits     = 0;
+         uint64_t    misses   = 0;
+   };
+}} // ns sysio::cdt
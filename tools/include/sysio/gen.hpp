@@ -459,6 +459,9 @@ struct generation_utils {
          {"signed_int",   "varint32"},
 
          {"basic_string<char>", "string"},
+         {"string_view", "string"},
+         {"basic_string_view<char>", "string"},
+         {"bytes_view", "bytes"},
 
          {"block_timestamp", "block_timestamp_type"},
          {"capi_name",    "name"},
@@ -670,6 +673,14 @@ struct generation_utils {
             return t+"[]";
          }
       }
+      else if ( is_template_specialization( type, {"span"} ) ) {
+         auto t = get_template_argument_as_string( type );
+         if ( t=="int8" || t=="uint8" ) {
+            return "bytes";
+         } else {
+            return t+"[]";
+         }
+      }
       //The following else if (is_tuple(type)) block is removed, because it causes sysio-cpp compilation
       //failure on any action that has std::tuple<Ts...> parameter, also the type sysio::non_unique this block
       //was supposed to handle is obsolete now.
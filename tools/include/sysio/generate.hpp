@@ -0,0 +1,83 @@
+#pragma once
+
+#include <sysio/abigen.hpp>
+#include <sysio/codegen.hpp>
+
+#include <chrono>
+
+namespace sysio { namespace cdt {
+   /**
+    * State of the combined abigen and codegen pass over the current translation unit
+    */
+   class generation {
+      public:
+         using clock = std::chrono::steady_clock;
+
+         bool                      abigen_requested = false;
+         bool                      abigen_failed    = false;
+         bool                      abi_empty        = false;
+         std::chrono::microseconds parse_time{0};
+         std::chrono::microseconds generation_time{0};
+
+         static generation& get() {
+            static generation inst;
+            return inst;
+         }
+
+         void reset(bool abigen) {
+            abigen_requested = abigen;
+            abigen_failed    = false;
+            abi_empty        = false;
+            parse_time       = std::chrono::microseconds{0};
+            generation_time  = std::chrono::microseconds{0};
+         }
+   };
+
+   /**
+    * Runs abigen and then codegen over a single parse of the translation unit. The ABI is handed to codegen in
+    * between, as the dispatchers it emits embed it.
+    */
+   class sysio_generate_consumer : public ASTConsumer {
+      private:
+         sysio_abigen_consumer  abigen_consumer;
+         sysio_codegen_consumer codegen_consumer;
+         generation::clock::time_point start;
+
+      public:
+         explicit sysio_generate_consumer(CompilerInstance *CI, std::string file, generation::clock::time_point start)
+            : abigen_consumer(CI, file), codegen_consumer(CI, file), start(start) { }
+
+         virtual void HandleTranslationUnit(ASTContext &Context) {
+            using std::chrono::duration_cast;
+            using std::chrono::microseconds;
+            generation& gen = generation::get();
+            const auto parsed = generation::clock::now();
+            gen.parse_time = duration_cast<microseconds>(parsed - start);
+
+            abigen_consumer.HandleTranslationUnit(Context);
+            if (Context.getDiagnostics().hasErrorOccurred()) {
+               gen.abigen_failed = true;
+            } else {
+               if (!abigen::get().is_empty()) {
+                  std::string abi_s;
+                  abigen::get().to_json().dump(abi_s);
+                  codegen::get().set_abi(abi_s);
+               } else {
+                  // whether an empty ABI is an error is left to handle_empty_abigen, the dispatchers of contracts
+                  // with only notify handlers are still needed
+                  gen.abi_empty = gen.abigen_requested;
+               }
+               codegen_consumer.HandleTranslationUnit(Context);
+            }
+            gen.generation_time = duration_cast<microseconds>(generation::clock::now() - parsed);
+         }
+   };
+
+   class sysio_generate_frontend_action : public ASTFrontendAction {
+      public:
+         virtual std::unique_ptr<ASTConsumer> CreateASTConsumer(CompilerInstance &CI, StringRef file) {
+            CI.getPreprocessor().addPPCallbacks(std::make_unique<sysio_ppcallbacks>(CI.getSourceManager(), file.str()));
+            return std::make_unique<sysio_generate_consumer>(&CI, file, generation::clock::now());
+         }
+   };
+}} // ns sysio::cdt
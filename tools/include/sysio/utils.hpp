@@ -2,7 +2,10 @@
 
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Program.h"
+#include "llvm/Support/raw_ostream.h"
 
 #include <stdlib.h>
 #if defined(__APPLE__)
@@ -13,6 +16,10 @@ extern char **environ;
 #endif
 
 #include "whereami/whereami.hpp"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <sstream>
 
@@ -134,7 +141,8 @@ struct environment {
    }
    static bool exec_subprogram(const std::string prog, std::vector<std::string> options, bool root=false,
                                llvm::Optional<std::string> stdin_file = llvm::None,
-                               llvm::Optional<std::string> stdout_file = llvm::None) {
+                               llvm::Optional<std::string> stdout_file = llvm::None,
+                               llvm::Optional<std::string> stderr_file = llvm::None) {
       std::vector<llvm::StringRef> args;
       args.push_back(prog);
       args.insert(args.end(), options.begin(), options.end());
@@ -143,12 +151,14 @@ struct environment {
          find_path = "/usr/bin";
       if ( const auto& path = llvm::sys::findProgramByName(prog.c_str(), {find_path}) ) {
          std::vector<llvm::Optional<llvm::StringRef>> redirects;
-         if(stdin_file || stdout_file)
+         if(stdin_file || stdout_file || stderr_file)
             redirects = { llvm::None, llvm::None, llvm::None };
          if(stdin_file)
             redirects[0] = llvm::StringRef{*stdin_file};
          if(stdout_file)
             redirects[1] = llvm::StringRef{*stdout_file};
+         if(stderr_file)
+            redirects[2] = llvm::StringRef{*stderr_file};
          return llvm::sys::ExecuteAndWait(*path, args, {}, redirects, 0, 0, nullptr, nullptr) == 0;
       }
       else
@@ -156,5 +166,52 @@ struct environment {
       return true;
    }
 
+   struct subprogram_job {
+      std::vector<std::string>    options;
+      llvm::Optional<std::string> stdin_file;
+   };
+
+   /**
+    * Runs `prog` once for every job, with up to `jobs` of them running at the same time. When more than one runs at a
+    * time, the diagnostics of each run are collected and printed in one piece once it finishes.
+    *
+    * @return true if every run succeeded
+    */
+   static bool exec_subprograms(const std::string& prog, const std::vector<subprogram_job>& job_list, unsigned jobs) {
+      jobs = std::max(1u, std::min<unsigned>(jobs, job_list.size()));
+      if (jobs == 1) {
+         for (const auto& job : job_list) {
+            if (!exec_subprogram(prog, job.options, false, job.stdin_file))
+               return false;
+         }
+         return true;
+      }
+
+      std::atomic<size_t> next{0};
+      std::atomic<bool>   success{true};
+      std::mutex          diagnostics_mutex;
+      auto worker = [&]() {
+         for (size_t i = next++; i < job_list.size(); i = next++) {
+            llvm::SmallString<64> diagnostics;
+            llvm::sys::fs::createTemporaryFile("antelope", ".log", diagnostics);
+            if (!exec_subprogram(prog, job_list[i].options, false, job_list[i].stdin_file, llvm::None, diagnostics.str().str()))
+               success = false;
+            if (auto buffer = llvm::MemoryBuffer::getFile(diagnostics)) {
+               std::lock_guard<std::mutex> lock(diagnostics_mutex);
+               llvm::errs() << (*buffer)->getBuffer();
+               llvm::errs().flush();
+            }
+            llvm::sys::fs::remove(diagnostics);
+         }
+      };
+
+      std::vector<std::thread> workers;
+      for (unsigned i = 1; i < jobs; ++i)
+         workers.emplace_back(worker);
+      worker();
+      for (auto& w : workers)
+         w.join();
+      return success;
+   }
 };
 }} // ns sysio::cdt